@@ -0,0 +1,22 @@
+#include <Arduino.h>
+
+#ifndef AUDIO_h
+#define AUDIO_h
+
+#define AUDIO_SAMPLE_RATE 2000 // Hz, at most, the ADC disrupts WiFi if read much faster
+#define AUDIO_WINDOW_US 32000 // samples are analyzed in windows this long, ~31Hz per band
+#define AUDIO_MIN_SAMPLES 16 // a window with fewer than this (the loop was busy) is skipped
+#define AUDIO_NUM_BANDS 8
+#define AUDIO_SINE_SIZE 64 // entries in one cycle of the sine table
+
+typedef uint16_t (*AudioSampleReader)();
+
+void audioSetup();
+void audioSetSource(AudioSampleReader reader);
+void audioSample();
+void audioPushSample(uint16_t raw, unsigned long atUs);
+uint8_t audioBandLevel(uint8_t band);
+uint32_t audioWindowCount();
+uint32_t audioSkippedWindows();
+
+#endif
@@ -0,0 +1,31 @@
+#include <Arduino.h>
+
+#ifndef BUTTON_h
+#define BUTTON_h
+
+#define BUTTON_PIN D5 // GPIO14, D0 (GPIO16) can't raise interrupts
+#define BUTTON_DEBOUNCE_MS 25 // edges closer than this are contact bounce
+#define BUTTON_CLICK_MS 500 // presses shorter than this are clicks
+#define BUTTON_MULTI_CLICK_MS 300 // max gap between the clicks of a double or triple click
+#define BUTTON_MAX_CLICKS 3
+#define BUTTON_MAX_HOLDS 4
+#define BUTTON_EDGE_BUFFER 32 // must be a power of two that divides 256
+
+typedef void (*ButtonHandler)();
+
+// boot time helpers, these block
+bool buttonBegin(unsigned long holdMs);
+bool buttonHeldFor(unsigned long ms);
+
+bool buttonIsPressed();
+void buttonOnClicks(uint8_t clicks, ButtonHandler handler);
+void buttonOnReleasedAfter(unsigned long ms, ButtonHandler handler);
+void buttonOnHold(unsigned long ms, ButtonHandler handler);
+void buttonUpdate();
+uint16_t buttonDroppedEdges();
+
+// light sleep only wakes on a low level, these switch the pin over and back
+void buttonArmWakeup();
+void buttonDisarmWakeup();
+
+#endif
@@ -17,30 +17,78 @@ enum {
   status_custom,
 };
 
+// what the renderer hasn't been told about yet
+enum {
+  change_color = 1,
+  change_brightness = 2,
+  change_speed = 4,
+  change_mode = 8,
+  change_rate = 16,
+  change_all = 31,
+};
+
 enum {
   disconnected = 0,
   inConfig = 1,
   connected = 2,
 };
 
-const char* STATUSES[] = {
-  "Free",
-  "Busy",
-  "DND",
-  "Unknown",
-  "Party!"
+// names live in flash, read them with statusName() and effectName()
+const char STATUS_FREE[] PROGMEM = "Free";
+const char STATUS_BUSY[] PROGMEM = "Busy";
+const char STATUS_DND[] PROGMEM = "DND";
+const char STATUS_UNKNOWN[] PROGMEM = "Unknown";
+const char STATUS_PARTY[] PROGMEM = "Party!";
+
+const char* const STATUSES[] PROGMEM = {
+  STATUS_FREE,
+  STATUS_BUSY,
+  STATUS_DND,
+  STATUS_UNKNOWN,
+  STATUS_PARTY
 };
 
-const char* NEO_MODE_NAMES[] = {
-  "solid",
-  "breath",
-  "marquee",
-  "theater",
-  "rainbow",
-  "rainbow_marquee",
-  "rainbow_theater"
+const char MODE_SOLID[] PROGMEM = "solid";
+const char MODE_BREATH[] PROGMEM = "breath";
+const char MODE_MARQUEE[] PROGMEM = "marquee";
+const char MODE_THEATER[] PROGMEM = "theater";
+const char MODE_RAINBOW[] PROGMEM = "rainbow";
+const char MODE_RAINBOW_MARQUEE[] PROGMEM = "rainbow_marquee";
+const char MODE_RAINBOW_THEATER[] PROGMEM = "rainbow_theater";
+const char MODE_SPARKLE[] PROGMEM = "sparkle";
+const char MODE_TWINKLE[] PROGMEM = "twinkle";
+const char MODE_FIRE[] PROGMEM = "fire";
+const char MODE_METEOR[] PROGMEM = "meteor";
+const char MODE_AUDIO[] PROGMEM = "audio";
+
+// same order as the effect list in light.cpp
+const char* const NEO_MODE_NAMES[] PROGMEM = {
+  MODE_SOLID,
+  MODE_BREATH,
+  MODE_MARQUEE,
+  MODE_THEATER,
+  MODE_RAINBOW,
+  MODE_RAINBOW_MARQUEE,
+  MODE_RAINBOW_THEATER,
+  MODE_SPARKLE,
+  MODE_TWINKLE,
+  MODE_FIRE,
+  MODE_METEOR,
+  MODE_AUDIO
 };
 
+#define NUM_STATUSES (sizeof(STATUSES) / sizeof(STATUSES[0]))
+#define NEO_MODE_NAME_SIZE 16 // the longest mode name and its terminator
+
+PGM_P statusName(uint8_t status) {
+  return (PGM_P)pgm_read_ptr(&STATUSES[status]);
+}
+
+// the name of the effect at position i in the effect list
+PGM_P effectName(uint8_t i) {
+  return (PGM_P)pgm_read_ptr(&NEO_MODE_NAMES[i]);
+}
+
 bool USE_WIFI = true;
 int wiFiStatus = disconnected;
 char customStatus[80];
@@ -49,13 +97,9 @@ uint8_t g = 255;
 uint8_t b = 0;
 uint8_t a = 50;
 
-uint8_t _r = 0;
-uint8_t _g = 255;
-uint8_t _b = 0;
-
 uint8_t MIN = 0;
 uint8_t MAX = 255;
-uint8_t MAX_A = 150;
+uint8_t MAX_A = NEO_BRIGHTNESS_MAX;
 uint8_t LOW_A = 25;
 uint8_t MED_A = 75;
 uint8_t HIGH_A = MAX_A;
@@ -63,11 +107,18 @@ uint8_t MAX_SPEED = 5;
 uint8_t MIN_SPEED = 1;
 
 uint8_t speed = 3;
+uint16_t rate = 0; // continuous speed in 1/256ths of 1x, 0 follows the speed tier
 
 byte _lastRand = 0;
 bool _resetFlagged = false;
+bool _hardResetPending = false;
 
 uint8_t neo_mode = off_mode;
+uint8_t lastOnMode = solid_mode;
 uint8_t currentStatus = status_unknown;
+uint8_t stateChanges = change_all;
+
+uint32_t bootHeap = 0; // free heap at the start of setup()
+uint32_t readyHeap = 0; // and at the end, with WiFi and the server up
 
 #endif
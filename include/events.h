@@ -0,0 +1,31 @@
+#include <Arduino.h>
+
+#ifndef EVENTS_h
+#define EVENTS_h
+
+#define EVENT_QUEUE_SIZE 16 // must be a power of two that divides 256
+
+// button and wifi inputs that change the status and mode, in the order they happened.
+// api, websocket, mqtt and group commands don't come through here: they're applied
+// from taskNetwork() and answer with the state they leave behind, so they call the
+// setters directly. both run on the loop, so the state still has a single writer,
+// and the renderer still only sees what the setters flag in stateChanges
+enum EVENT_TYPES {
+  event_click,
+  event_double_click,
+  event_triple_click,
+  event_long_click,
+  event_hold_color,
+  event_hold_party,
+  event_hold_off,
+  event_hold_reboot,
+  event_wifi_lost,
+  event_wifi_config,
+  event_wifi_connected,
+};
+
+bool eventsPush(uint8_t event);
+bool eventsPop(uint8_t* event);
+uint16_t eventsDropped();
+
+#endif
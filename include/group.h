@@ -0,0 +1,39 @@
+#include <Arduino.h>
+
+#ifndef GROUP_h
+#define GROUP_h
+
+#define GROUP_CONFIG_FILE "/group.json"
+#define GROUP_PRESET_FILE "/preset%u.json" // one saved POST /config body per preset
+#define GROUP_MAX_PRESETS 8 // preset ids are 1 to 8
+#define GROUP_DEFAULT_ADDRESS "239.76.73.71"
+#define GROUP_DEFAULT_PORT 4210
+#define GROUP_MAX_GROUPS 32 // group ids are 1 to 32, 0 addresses every device
+#define GROUP_MAX_PACKET 256
+#define GROUP_MAX_SENDERS 8 // senders we remember sequence numbers for
+#define GROUP_SENDER_TTL 60000 // ms before a quiet sender's sequence is forgotten
+#define GROUP_PACKETS_PER_LOOP 4
+
+// header: 'S' 'L' version group seq[4, big endian] command, then the arguments
+#define GROUP_HEADER_SIZE 9
+#define GROUP_VERSION 1
+
+enum GROUP_COMMANDS {
+  group_status = 1, // status index
+  group_color, // r g b, optionally a
+  group_mode, // mode number
+  group_config, // a POST /config body, for anything else
+  group_preset, // preset id, applies the body saved on each light
+};
+
+typedef String (*GroupCommandHandler)(String body);
+
+void groupSetup(GroupCommandHandler onCommand, const char* const* statuses, uint8_t numStatuses); // a PROGMEM table of PROGMEM names
+bool groupConfigure(String address, uint16_t port, uint32_t groups, bool persist);
+void groupRejoin();
+String groupGetConfigAsJson();
+bool groupSavePreset(uint8_t preset, String body); // an empty body clears it
+String groupGetPresetsAsJson();
+bool groupLoop();
+
+#endif
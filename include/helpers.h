@@ -7,5 +7,7 @@
 String makeErrorJson(String errorMessage);
 String makeSimpleJson(String key, int value);
 String makeSimpleJson(String key, String value);
+int hexToBytes(String hex, uint8_t* bytes, size_t maxLen);
+String bytesToHex(const uint8_t* bytes, size_t len);
 
 #endif
@@ -0,0 +1,27 @@
+#include <Arduino.h>
+
+#ifndef HISTORY_h
+#define HISTORY_h
+
+#define HISTORY_FILE "/history.bin"
+#define HISTORY_SIZE 48 // status changes kept, oldest are overwritten
+#define HISTORY_RECENT 16 // changes returned by GET /status/history
+#define HISTORY_DAYS 7 // days of per status totals
+#define HISTORY_MAX_BUILTIN 8
+#define HISTORY_MAX_CUSTOM 7 // custom statuses remembered, the least used is forgotten first
+#define HISTORY_MAX_STATUSES (HISTORY_MAX_BUILTIN + HISTORY_MAX_CUSTOM)
+#define HISTORY_NAME_SIZE 80 // same as customStatus
+#define HISTORY_FOLD_MS 60000 // durations are added up at least this often
+#define HISTORY_SAVE_MS 60000 // min time between saves after a status change
+#define HISTORY_SYNC_MS 600000 // durations are saved this often even without a change
+#define HISTORY_MAGIC 0x48535401 // "HST" and the layout version
+
+#ifndef HISTORY_TZ
+#define HISTORY_TZ "UTC0" // POSIX TZ string, days roll over at midnight here
+#endif
+
+void historySetup(const char* const* statuses, uint8_t numStatuses); // a PROGMEM table of PROGMEM names
+void historyLoop(uint8_t status, const char* custom); // custom is used when status isn't one of the built in ones
+String historyGetAsJson();
+
+#endif
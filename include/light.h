@@ -4,6 +4,14 @@
 #ifndef NEOPIXEL_LIGHT_h
 #define NEOPIXEL_LIGHT_h
 
+#define NEO_BRIGHTNESS_MAX 150 // brightness as set through the api, mapped onto 0-255
+#define NEO_RATE_ONE 256 // 1x speed, rates are fixed point in 1/256ths
+#define NEO_RATE_MIN (NEO_RATE_ONE / 10)
+#define NEO_RATE_MAX (NEO_RATE_ONE * 10)
+#define NEO_MAX_ELAPSED_MS 1000 // longer stalls than this don't fast forward the animation
+#define NEO_MAX_STEPS_PER_LOOP 16 // owed steps rendered per call, the rest carry over to the next
+#define NEO_MAX_OWED_STEPS 128 // a backlog longer than this is dropped, the loop can't keep up
+
 enum NEO_MODES {
   solid_mode,
   breath_mode,
@@ -12,13 +20,56 @@ enum NEO_MODES {
   rainbow_mode,
   rainbow_marquee_mode,
   rainbow_theater_mode,
-  MODE_END,
-  off_mode = 10,
+  sparkle_mode,
+  twinkle_mode,
+  fire_mode,
+  off_mode = 10, // mode_num is part of the api, so these never change
+  pattern_mode = 11,
+  segments_mode = 12,
+  meteor_mode = 13,
+  audio_mode = 14,
+  MODE_END, // one past the highest mode number, see neoIsEffect() for which ones are effects
 };
 
+typedef unsigned long (*NeoClock)();
+typedef void (*NeoFrameHook)(unsigned long time, unsigned long showUs);
+
+extern Adafruit_NeoPixel strip;
+
 void neoSetup();
-int getLastNeoMode();
-void neoLoop(uint8_t r, uint8_t g, uint8_t b, uint8_t a, uint8_t neo_mode, uint8_t neo_speed);
+void neoSetClock(NeoClock clock);
+void neoSetFrameHook(NeoFrameHook hook);
+void neoSetOutput(bool enabled);
+void neoRestart();
+unsigned long neoNow();
+void neoShow();
+void neoSetPixel(uint16_t i, uint32_t color);
+void neoFill(uint32_t color, uint16_t first = 0, uint16_t count = 0);
+uint32_t neoFrameCount();
+uint32_t neoStepCount();
+uint32_t neoOwedSteps();
+uint32_t neoDroppedStepCount();
+uint16_t neoEstimatedMilliamps();
+uint16_t neoMilliampBudget();
+uint32_t neoLimitedFrameCount();
+const uint8_t* neoPixels();
+uint16_t neoPixelBytes();
+uint8_t neoBytesPerPixel();
+uint16_t neoLimitScale();
+uint8_t neoCurrentMode();
+uint8_t neoEffectCount();
+uint8_t neoEffectAt(uint8_t i);
+int8_t neoEffectIndex(uint8_t mode);
+bool neoIsEffect(uint8_t mode);
+void neoSetColor(uint8_t r, uint8_t g, uint8_t b);
+void neoSetBrightness(uint8_t a);
+void neoSetSpeed(uint8_t speed);
+void neoSetRate(uint16_t rate);
+uint16_t neoRateForSpeed(uint8_t speed);
+void neoSetMode(uint8_t neo_mode);
+unsigned long getDelayForSpeed(unsigned long currentDelay, uint8_t neo_speed);
+void neoLoop();
+bool neoIsIdle();
 
 void breathe();
 void marquee();
@@ -26,6 +77,9 @@ void theater();
 void rainbow();
 void rainbowMarquee();
 void rainbowTheater();
+void sparkle();
+void particleEffect(uint8_t neo_mode);
+void audioEffect();
 
 void solidRed();
 void solidBlue();
@@ -0,0 +1,31 @@
+#include <Arduino.h>
+
+#ifndef LINK_h
+#define LINK_h
+
+#define LINK_CONFIG_FILE "/wifi.json"
+#define LINK_FAST_JOIN_MS 3000 // how long a join to the cached access point gets before we scan
+#define LINK_RTC_OFFSET 32 // rtc user memory block the cache lives in, survives resets but not power loss; blocks 0-31 hold the ota boot command
+#define LINK_CACHE_MAGIC 0x4c4e4b01 // "LNK" and the layout version
+
+enum LINK_STATES {
+  link_down,
+  link_fast_join, // joining the cached access point on its channel, no scan
+  link_scan_join, // scanning for any access point with our ssid
+  link_up,
+};
+
+// pure, so the reconnect logic can be stepped through off the device
+uint8_t linkNextState(uint8_t state, bool connected, bool haveCache, unsigned long inStateMs);
+
+void linkSetup();
+bool linkFastConnect();
+void linkLoop();
+bool linkConfigureStatic(String ip, String gateway, String subnet, String dns, bool persist);
+String linkGetConfigAsJson();
+unsigned long linkBootConnectMs();
+unsigned long linkLastConnectMs();
+bool linkLastJoinWasFast();
+uint32_t linkReconnectCount();
+
+#endif
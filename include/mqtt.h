@@ -0,0 +1,23 @@
+#include <Arduino.h>
+
+#ifndef MQTT_h
+#define MQTT_h
+
+#define MQTT_CONFIG_FILE "/mqtt.json"
+#define MQTT_MIN_BACKOFF 1000 // ms between reconnect attempts, doubled on each failure
+#define MQTT_MAX_BACKOFF 60000
+#define MQTT_CONNECT_TIMEOUT 10000 // ms before an unfinished connect is abandoned, it never blocks the loop
+#define MQTT_BUFFER_SIZE 1536 // large enough for the Home Assistant discovery payload, and the largest command accepted
+#define MQTT_MAX_PENDING 4 // commands buffered between loops, more are dropped
+
+typedef String (*MqttCommandHandler)(String body);
+typedef String (*MqttStateGetter)();
+typedef uint32_t (*MqttVersionGetter)();
+
+void mqttSetup(String deviceId, MqttCommandHandler onCommand, MqttStateGetter getState, MqttVersionGetter getVersion);
+void mqttSetEffects(const char* const* names, uint8_t count); // a PROGMEM table of PROGMEM names
+bool mqttConfigure(String host, uint16_t port, String user, String password, String topic, bool persist);
+String mqttGetConfigAsJson();
+void mqttLoop();
+
+#endif
@@ -0,0 +1,25 @@
+#include <Arduino.h>
+
+#ifndef PARTICLES_h
+#define PARTICLES_h
+
+#ifndef PARTICLE_MAX_PIXELS
+#define PARTICLE_MAX_PIXELS 300
+#endif
+
+#define PARTICLE_POOL_SIZE 32
+
+// positions and velocities are Q8 fixed point, in pixels and pixels per frame
+typedef struct {
+  int32_t pos;
+  int16_t vel;
+  uint8_t hue;
+  uint8_t life; // 0 means the particle is free
+} Particle;
+
+void particlesReset(uint16_t numPixels);
+void particlesFire();
+void particlesTwinkle();
+void particlesMeteor();
+
+#endif
@@ -0,0 +1,30 @@
+#include <Arduino.h>
+
+#ifndef PATTERN_h
+#define PATTERN_h
+
+#define PATTERN_MAX_BYTES 256
+#define PATTERN_MAX_LOOP_DEPTH 4
+#define PATTERN_OPS_PER_FRAME 16 // max instructions interpreted per neoLoop() call
+#define PATTERN_FRAME_MS 20 // min time between frames while fading
+#define PATTERN_FILE "/pattern.bin"
+
+// bytecode format, all durations are big endian milliseconds
+enum PATTERN_OPS {
+  op_end,     // 0x00                   restart from the top
+  op_set,     // 0x01 r g b             set the segment to a color
+  op_fade,    // 0x02 r g b t_hi t_lo   fade the segment to a color over t ms
+  op_hold,    // 0x03 t_hi t_lo         hold the current frame for t ms
+  op_loop,    // 0x04 n                 start a loop that runs n times (0 = forever)
+  op_next,    // 0x05                   jump back to the matching op_loop
+  op_segment, // 0x06 start count       apply following ops to a pixel range (count 0 = to the end)
+  OP_END,
+};
+
+void patternSetup();
+bool patternLoad(const uint8_t* code, size_t len, bool persist);
+const uint8_t* patternCode();
+size_t patternLength();
+void patternLoop(bool restart);
+
+#endif
@@ -0,0 +1,111 @@
+#include <Arduino.h>
+#include <Adafruit_NeoPixel.h>
+
+#ifndef PIXELS_h
+#define PIXELS_h
+
+// Writes colors straight into the strip's pixel buffer for one pixel order and
+// length known at compile time. Adafruit_NeoPixel works out byte offsets and the
+// white channel per call, here they are constants so packing a pixel is a
+// handful of stores. TYPE is one of the NEO_RGB, NEO_GRB, NEO_GRBW... orders,
+// COUNT is the strip length.
+template <neoPixelType TYPE, uint16_t COUNT>
+struct PixelWriter {
+  // NEO_* packs the byte offset of each channel into 2 bits: wwrrggbb
+  static const uint8_t R = (TYPE >> 4) & 0x03;
+  static const uint8_t G = (TYPE >> 2) & 0x03;
+  static const uint8_t B = TYPE & 0x03;
+  static const uint8_t W = (TYPE >> 6) & 0x03;
+  static const bool HAS_W = W != R; // RGB orders repeat the red offset for white
+  static const uint8_t BYTES = HAS_W ? 4 : 3;
+
+  // brightness as the strip stores it, 1 to 256 where 256 is full
+  static uint16_t scaleOf(const Adafruit_NeoPixel& strip) {
+    return (uint16_t)strip.getBrightness() + 1;
+  }
+
+  static inline void pack(uint8_t* p, uint32_t color, uint16_t scale) {
+    uint8_t r = color >> 16;
+    uint8_t g = color >> 8;
+    uint8_t b = color;
+
+    if (HAS_W) {
+      uint8_t w = color >> 24;
+
+      // drive the white led with whatever all three colors share
+      if (!w) {
+        w = min(r, min(g, b));
+        r -= w;
+        g -= w;
+        b -= w;
+      }
+
+      p[W] = (w * scale) >> 8;
+    }
+
+    p[R] = (r * scale) >> 8;
+    p[G] = (g * scale) >> 8;
+    p[B] = (b * scale) >> 8;
+  }
+
+  static void set(Adafruit_NeoPixel& strip, uint16_t i, uint32_t color) {
+    if (i < COUNT) {
+      pack(strip.getPixels() + i * BYTES, color, scaleOf(strip));
+    }
+  }
+
+  // same arguments as Adafruit_NeoPixel::fill(), a count of 0 runs to the end
+  static void fill(Adafruit_NeoPixel& strip, uint32_t color, uint16_t first, uint16_t count) {
+    if (first >= COUNT) {
+      return;
+    }
+
+    uint16_t last = (count && count < COUNT - first) ? first + count : COUNT;
+    uint8_t px[BYTES];
+    uint8_t* p = strip.getPixels() + first * BYTES;
+
+    pack(px, color, scaleOf(strip));
+
+    for (uint16_t i = first; i < last; i++, p += BYTES) {
+      memcpy(p, px, BYTES);
+    }
+  }
+
+  // every channel of every pixel added up, one add per byte
+  static uint32_t load(const Adafruit_NeoPixel& strip) {
+    const uint8_t* p = strip.getPixels();
+    uint32_t sum = 0;
+
+    for (uint16_t i = 0; i < COUNT * BYTES; i++) {
+      sum += p[i];
+    }
+
+    return sum;
+  }
+
+  // dim the whole buffer, scale is out of 256
+  static void scale(Adafruit_NeoPixel& strip, uint16_t scale) {
+    uint8_t* p = strip.getPixels();
+
+    for (uint16_t i = 0; i < COUNT * BYTES; i++) {
+      p[i] = (p[i] * scale) >> 8;
+    }
+  }
+};
+
+// estimated draw of a frame, from its load: maPerChannel for one channel at
+// full, and idleMa for the strip even when it's dark
+inline uint32_t pixelsMilliamps(uint32_t load, uint16_t maPerChannel, uint16_t idleMa) {
+  return load * maPerChannel / 255 + idleMa;
+}
+
+// how far a frame drawing ma has to be dimmed to fit the budget, out of 256
+inline uint16_t pixelsLimitScale(uint32_t ma, uint16_t budgetMa, uint16_t idleMa) {
+  if (ma <= budgetMa) {
+    return 256;
+  }
+
+  return budgetMa > idleMa ? (budgetMa - idleMa) * 256UL / (ma - idleMa) : 0;
+}
+
+#endif
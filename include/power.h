@@ -0,0 +1,23 @@
+#include <Arduino.h>
+
+#ifndef POWER_h
+#define POWER_h
+
+#define POWER_IDLE_AFTER_MS 5000 // stay fully awake this long after any input
+#define POWER_IDLE_SLEEP_MS 50 // slept per idle loop, added to button and api latency while idle
+#define POWER_LISTEN_INTERVAL 3 // DTIM beacons slept through while idle, ~100ms each
+#define POWER_WINDOW_MS 10000 // duty cycle is measured over this window
+#define POWER_AWAKE_MA 70 // rough module draw with the cpu and radio awake
+#define POWER_SLEEP_MA 1 // rough module draw in light sleep
+
+typedef void (*PowerWakeHook)();
+
+void powerSetup(bool useWiFi, PowerWakeHook armWakeup, PowerWakeHook disarmWakeup);
+void powerActivity();
+void powerLoop(bool canSleep);
+bool powerIsIdle();
+uint8_t powerDutyCycle();
+uint16_t powerEstimatedMilliamps();
+uint32_t powerSleepCount();
+
+#endif
@@ -0,0 +1,13 @@
+#include <Arduino.h>
+
+#ifndef RNG_h
+#define RNG_h
+
+void rngSeed(uint32_t seed);
+void rngSeedFromHardware();
+uint32_t rngSeedValue();
+uint32_t rngNext();
+uint8_t rngByte();
+uint16_t rngRange(uint16_t n);
+
+#endif
@@ -0,0 +1,28 @@
+#include <Arduino.h>
+
+#ifndef SCHEDULER_h
+#define SCHEDULER_h
+
+#define SCHEDULER_MAX_TASKS 8
+#define SCHEDULER_MAX_TIMERS 4
+#define SCHEDULER_PASS_BUDGET_US 20000 // once a pass has done this much work, only guaranteed tasks still run
+#define SCHEDULER_MAX_DEFER_MS 100 // a task this late runs no matter what, and counts a deadline miss
+
+// lower runs first, input and render run on every pass
+enum TASK_PRIORITIES {
+  priority_input,
+  priority_render,
+  priority_network,
+  priority_housekeeping,
+};
+
+typedef void (*TaskHandler)();
+
+bool schedulerAdd(const char* name, TaskHandler handler, uint8_t priority, unsigned long budgetUs);
+bool schedulerAfter(unsigned long ms, TaskHandler handler);
+void schedulerLoop();
+
+uint8_t schedulerTaskCount();
+void schedulerGetTask(uint8_t i, const char** name, uint32_t* runs, uint32_t* misses, uint32_t* overruns, uint32_t* maxUs);
+
+#endif
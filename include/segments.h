@@ -0,0 +1,14 @@
+#include <Arduino.h>
+
+#ifndef SEGMENTS_h
+#define SEGMENTS_h
+
+#define MAX_SEGMENTS 8
+
+void segmentsClear();
+bool segmentsAdd(uint16_t first, uint16_t count, uint8_t r, uint8_t g, uint8_t b, uint8_t neo_mode, uint8_t neo_speed);
+uint8_t segmentsCount();
+void segmentsGet(uint8_t i, uint16_t* first, uint16_t* count, uint8_t* rgb, uint8_t* neo_mode, uint8_t* neo_speed);
+void segmentsLoop(bool restart, bool redraw);
+
+#endif
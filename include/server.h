@@ -0,0 +1,62 @@
+#include <Arduino.h>
+
+#ifndef SERVER_h
+#define SERVER_h
+
+#define SERVER_PORT 80
+#define SERVER_MAX_CONNECTIONS 8 // requests in flight before we answer 503
+#define SERVER_MAX_BODY 1024 // bytes buffered per POST before we answer 413
+#define SERVER_MAX_ROUTES 64 // paths and aliases together
+#define SERVER_RATE_CLIENTS 8 // clients tracked by the rate limiter, the oldest is forgotten first
+#define SERVER_RATE_BURST 20 // api requests a client can make back to back
+#define SERVER_RATE_PER_SEC 10 // sustained api requests per client before we answer 429
+
+class AsyncWebHandler;
+
+typedef String (*GetHandler)();
+typedef String (*ArgHandler)(String arg); // POST body, or the last path segment of a wildcard route
+
+enum ROUTE_METHODS {
+  route_get = 1,
+  route_post = 2,
+};
+
+typedef struct {
+  uint32_t hash;
+  const char* path; // in flash
+  uint32_t aliasHash;
+  const char* alias; // in flash
+  uint8_t method;
+  GetHandler get;
+  ArgHandler withArg;
+} Route;
+
+// FNV-1a of the method and path, so route hashes are computed by the compiler
+constexpr uint32_t routeHash(const char* path, uint32_t hash) {
+  return *path ? routeHash(path + 1, (hash ^ (uint8_t)*path) * 16777619UL) : hash;
+}
+
+constexpr uint32_t routeHash(uint8_t method, const char* path) {
+  return routeHash(path, 2166136261UL ^ method);
+}
+
+template <uint32_t HASH>
+struct RouteHash {
+  static constexpr uint32_t value = HASH;
+};
+
+// the hash is forced to compile time, so the literal is only ever stored in flash by PSTR()
+#define ROUTE_HASH(method, path) (RouteHash<routeHash(method, path)>::value)
+#define ROUTE_PATH(path) ([]() -> PGM_P { return PSTR(path); }())
+
+// a path ending in "/*" matches any last segment, which is passed to the handler
+#define ROUTE_GET(path, handler) { ROUTE_HASH(route_get, path), ROUTE_PATH(path), 0, NULL, route_get, handler, NULL }
+#define ROUTE_GET_ALIAS(path, alias, handler) { ROUTE_HASH(route_get, path), ROUTE_PATH(path), ROUTE_HASH(route_get, alias), ROUTE_PATH(alias), route_get, handler, NULL }
+#define ROUTE_GET_PARAM(path, handler) { ROUTE_HASH(route_get, path), ROUTE_PATH(path), 0, NULL, route_get, NULL, handler }
+#define ROUTE_POST(path, handler) { ROUTE_HASH(route_post, path), ROUTE_PATH(path), 0, NULL, route_post, NULL, handler }
+
+void serverBegin(const Route* routes, uint8_t numRoutes);
+void serverAddHandler(AsyncWebHandler* handler);
+bool serverLoop();
+
+#endif
@@ -0,0 +1,26 @@
+#include <Arduino.h>
+
+#ifndef TRACE_h
+#define TRACE_h
+
+#define TRACE_SIZE 64 // records kept, oldest are overwritten
+#define TRACE_BUDGET_US 20 // most a frame may spend recording itself
+#define TRACE_REPLAY_MAX_MS 10000 // longest replay, in ms on the fake clock
+#define TRACE_REPLAY_MAX_LOG 256 // frames logged per replay, the rest are only counted
+
+enum TRACE_TYPES {
+  trace_frame,
+  trace_color, // value is 0xrrggbb
+  trace_brightness,
+  trace_rate, // in 1/256ths of normal speed
+  trace_mode,
+};
+
+void traceStart(uint32_t seed);
+void traceStop();
+bool traceIsRecording();
+void traceState(uint8_t type, uint32_t value);
+String traceGetAsJson();
+String traceReplay(uint8_t mode, uint32_t color, uint8_t brightness, uint16_t rate, uint32_t seed, unsigned long ms, unsigned long step);
+
+#endif
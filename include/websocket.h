@@ -0,0 +1,28 @@
+#include <Arduino.h>
+
+#ifndef WEBSOCKET_h
+#define WEBSOCKET_h
+
+#define WEBSOCKET_PATH "/ws"
+#define WEBSOCKET_MAX_CLIENTS 4
+
+// the latest value of everything sent since the last frame, older values are dropped
+typedef struct {
+  bool hasColor;
+  uint8_t r;
+  uint8_t g;
+  uint8_t b;
+  bool hasBrightness;
+  uint8_t a;
+  bool hasSpeed;
+  uint8_t speed;
+} LiveUpdate;
+
+typedef void (*LiveUpdateHandler)(LiveUpdate update);
+typedef String (*LiveStateGetter)();
+typedef uint32_t (*LiveVersionGetter)();
+
+void websocketSetup(LiveUpdateHandler onUpdate, LiveStateGetter getState, LiveVersionGetter getVersion);
+void websocketLoop();
+
+#endif
@@ -0,0 +1,281 @@
+// generated by scripts/embed_www.py from var/www, do not edit
+#include <Arduino.h>
+
+#ifndef WWW_h
+#define WWW_h
+
+// everything is in flash, copy an entry out with memcpy_P() and read its strings with the _P functions
+typedef struct {
+  const char* path;
+  const char* type;
+  const uint8_t* data;
+  size_t len;
+  const char* etag;
+  const char* cacheControl;
+} WwwAsset;
+
+// index.css: 4185 bytes minified, 1378 bytes gzipped
+const uint8_t WWW_INDEX_CSS[] PROGMEM = {
+  0x1f,0x8b,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0x03,0xbd,0x56,0xc1,0x6e,0xe3,0x36,0x10,0xfd,0x15,0x35,0xc6,0x02,0x71,0x6a,
+  0x0a,0xb2,0x13,0xad,0x77,0x25,0x20,0x68,0xd1,0x4b,0x7b,0xe9,0x61,0x8b,0xa2,0x67,0x4a,0x1c,0xd9,0x6c,0x28,0x51,0xa0,0x28,
+  0xc7,0x5e,0xc1,0xff,0xde,0x21,0x29,0xc9,0xb4,0x6c,0x27,0xbb,0x45,0x51,0x04,0x48,0x94,0x21,0x39,0x33,0x9c,0xf7,0xe6,0x0d,
+  0x13,0x25,0xa5,0xee,0x08,0xc9,0x74,0xf5,0x17,0x67,0x7a,0x9b,0x2c,0xd7,0x71,0xbd,0x4f,0xad,0xe1,0x0b,0x65,0xbc,0x6d,0x92,
+  0x28,0x5c,0xc5,0x0a,0x4a,0xb4,0xe9,0x2d,0x94,0xf0,0x8b,0x14,0x52,0x25,0x99,0xa0,0xf9,0x0b,0x9a,0x4a,0xaa,0x36,0xbc,0x4a,
+  0x56,0x11,0x1e,0x3a,0x3e,0x2c,0x1e,0x92,0x24,0x83,0x42,0x2a,0x30,0x5f,0xb4,0xd0,0xa0,0xba,0x4c,0xee,0x49,0xc3,0xbf,0xf2,
+  0x6a,0x93,0x64,0x52,0x31,0x50,0x04,0x2d,0xe9,0x31,0x93,0xec,0xd0,0xf5,0xa7,0xa3,0xb4,0x90,0x95,0x26,0x05,0x2d,0xb9,0x38,
+  0x24,0xcd,0xa1,0xd1,0x50,0x92,0x96,0x2f,0x08,0xad,0x6b,0x01,0xc4,0x19,0x16,0x77,0x7f,0xc0,0x46,0x42,0xf0,0xe7,0x6f,0x77,
+  0x8b,0x2f,0x32,0x93,0x5a,0x2e,0xee,0x7e,0x05,0xb1,0x03,0xcd,0x73,0x1a,0xfc,0x0e,0x2d,0xdc,0x2d,0x7e,0x56,0x9c,0x8a,0x45,
+  0x43,0xab,0x86,0x34,0xa0,0x78,0x91,0x0a,0x5e,0x01,0xd9,0x02,0xdf,0x6c,0x75,0xb2,0x0c,0xe3,0x34,0xb7,0xc9,0xcf,0x56,0xcb,
+  0x55,0xbc,0xfa,0x9c,0x1e,0xb7,0xcb,0xc5,0x76,0xb5,0xd8,0xc6,0x63,0x22,0x01,0xfe,0x84,0xf6,0xb6,0x36,0xa3,0x57,0x77,0x32,
+  0x8e,0xa2,0x89,0xa7,0x95,0x39,0xdb,0xd9,0x3d,0x78,0x37,0x48,0x72,0x2a,0xf2,0xfb,0x65,0xf8,0xb8,0x36,0x67,0x83,0x1f,0x03,
+  0x8c,0xb5,0x7b,0x9d,0xe3,0xa6,0xd5,0x95,0x4d,0xab,0x7e,0x53,0x14,0x7e,0x76,0x9b,0x62,0x6f,0xd3,0xb2,0xaf,0xf6,0x31,0xcc,
+  0xd1,0x46,0x31,0xaa,0x5a,0x9c,0x3e,0x49,0x21,0x5a,0xce,0xba,0x57,0x07,0x55,0x14,0x7d,0x48,0xc7,0xcc,0x69,0xab,0x65,0x5a,
+  0x53,0xc6,0x4c,0xa5,0xcd,0x35,0xd6,0x53,0x3f,0x78,0xcb,0x3d,0xe9,0x8f,0x2e,0x9f,0x2c,0x62,0x21,0xc2,0xdc,0x31,0xde,0xd4,
+  0x82,0x1e,0x12,0x5e,0xd9,0x4b,0x66,0x42,0x22,0xb4,0xa3,0xa7,0xe1,0x52,0x83,0x43,0x2f,0x55,0xf3,0xef,0xb4,0xc2,0x1a,0xf6,
+  0x9a,0x50,0xc1,0x37,0x55,0x92,0x43,0x85,0x04,0x70,0x16,0x06,0xb9,0x54,0x54,0x73,0x59,0x25,0x95,0xac,0x20,0xcd,0x5b,0xd5,
+  0x20,0x12,0xb5,0xe4,0x76,0x4f,0x8b,0x70,0x21,0x64,0x02,0x72,0xed,0xd6,0x1d,0x55,0x92,0x65,0xbd,0x0f,0x1a,0x29,0x38,0x0b,
+  0xb4,0x42,0x54,0x6b,0xaa,0xd0,0x67,0xbf,0x48,0x94,0xe3,0xe7,0x8e,0xaa,0x7b,0x8f,0xaf,0xf3,0x34,0x43,0x6a,0x6e,0x94,0x6c,
+  0x2b,0x96,0xf8,0xa7,0xec,0x65,0x89,0x6c,0xb5,0x4d,0x99,0x51,0xf5,0xd2,0x39,0x3a,0x38,0x07,0x27,0x72,0xcf,0x87,0x00,0xb7,
+  0x96,0x2f,0x3d,0x25,0x5b,0xb9,0x33,0x40,0x19,0x7b,0xbe,0x85,0xfc,0x25,0xb1,0xbf,0x81,0x21,0xcc,0xb7,0xc2,0xce,0x8a,0xa2,
+  0xf0,0x72,0x7d,0x27,0x5a,0xad,0x38,0x42,0x7d,0x78,0xf3,0xec,0x2c,0x62,0x1f,0xa1,0x60,0xe7,0xe9,0x0f,0xc6,0xe3,0x29,0xb9,
+  0xae,0x96,0x0d,0xb7,0x58,0xd0,0x0c,0xab,0xdb,0x6a,0xc4,0x43,0xf0,0x3a,0x51,0x58,0xfe,0xfb,0x68,0x61,0x7f,0xe6,0x69,0x8f,
+  0x0d,0x81,0x1d,0x56,0xaf,0x71,0xb0,0x38,0x27,0x26,0x68,0x3d,0xa5,0x4d,0x21,0x60,0xef,0xaf,0x3f,0x5b,0x6e,0x19,0x6b,0xb2,
+  0x0c,0x96,0x8e,0x9e,0xd3,0x65,0x74,0xaa,0xef,0x13,0x41,0x1b,0x8d,0x89,0x71,0xc1,0xe6,0x5d,0x9f,0xba,0x96,0x35,0x51,0x86,
+  0x53,0x03,0xc8,0x51,0x3a,0x8a,0x87,0xd6,0xb2,0x9c,0x2e,0x5e,0x77,0x5c,0x70,0x85,0x9e,0x65,0x41,0xf4,0xa1,0x86,0x79,0xdf,
+  0xe4,0x44,0x40,0xa1,0x13,0x82,0xcc,0x4a,0xbd,0x60,0xc6,0x78,0x2b,0xd6,0xf9,0x9a,0x17,0x8a,0x20,0xe6,0x46,0x7d,0x84,0xbd,
+  0x26,0x61,0xdc,0x14,0xd0,0x94,0x15,0x2b,0xdf,0x96,0xd5,0xd5,0xad,0xdf,0x96,0x5e,0xd4,0xf7,0xb5,0xc9,0xcd,0xe5,0x7a,0xd3,
+  0x57,0x77,0xde,0x0d,0x51,0xf0,0x03,0x2f,0x6b,0xa9,0x34,0x75,0x94,0x37,0xcd,0x3c,0x42,0xd5,0x63,0x84,0x02,0x5d,0x12,0x23,
+  0x0b,0x4a,0x8a,0x71,0xcd,0xb5,0xbd,0xa7,0x2c,0xdf,0xaa,0x00,0x17,0xad,0x3a,0xcb,0x81,0x3d,0x31,0xfa,0x5e,0x9b,0xf6,0x79,
+  0x60,0x87,0x6e,0xc0,0x57,0x34,0x9a,0x1b,0xe1,0x78,0xa3,0x1d,0x4a,0xc9,0xe8,0x29,0x6f,0xcb,0xcb,0x91,0xd0,0x05,0xdf,0x03,
+  0x4b,0x79,0xd5,0x80,0x29,0xe2,0x57,0xc2,0x2b,0x66,0x08,0x18,0xc5,0x91,0x2f,0x0b,0x6a,0x93,0xd1,0x81,0xe8,0x61,0x3c,0xfa,
+  0x0c,0x9b,0xad,0x7c,0x9d,0x14,0xa4,0x5f,0x42,0x70,0xa9,0x90,0x1b,0x4f,0x42,0x71,0x28,0x20,0x2c,0xbd,0xfc,0x2e,0x5d,0x69,
+  0x06,0x96,0xbb,0x23,0xa6,0xc2,0x78,0x93,0xce,0x0b,0xec,0xfa,0xf6,0x1c,0xb0,0xf0,0xd1,0xe9,0xb4,0x3b,0xb4,0x05,0xca,0x8c,
+  0x92,0xb8,0xff,0xcc,0x94,0x1c,0xbe,0x0b,0x9c,0xd4,0x28,0xe2,0x03,0x2c,0xcb,0xcb,0x53,0xdd,0x19,0x6f,0x7d,0x44,0x18,0xc0,
+  0x0a,0x3e,0x8e,0xdb,0x7b,0x57,0x67,0xb4,0xf8,0xbb,0x6d,0x34,0x2f,0x0e,0x43,0xd6,0xd6,0x48,0xa0,0x62,0x5e,0x97,0x5c,0xf3,
+  0x38,0xcb,0x6c,0x2b,0x56,0xd0,0x34,0x5e,0x71,0x46,0xb0,0xed,0xa3,0xc2,0x14,0xb8,0xe6,0x28,0x87,0xaa,0xc7,0xd9,0xde,0xb8,
+  0x1f,0x1a,0xf6,0x7b,0xe4,0xda,0x74,0x30,0x5c,0x90,0xeb,0xa6,0x58,0x7f,0xf7,0x34,0x70,0x19,0x85,0x9e,0xb1,0x93,0x35,0xcd,
+  0xb9,0x3e,0xd8,0x27,0x0f,0xce,0x65,0x57,0x54,0xaf,0x13,0x9d,0x73,0x67,0x98,0xa7,0x6f,0x96,0x0f,0x5d,0xe6,0x38,0x4b,0x41,
+  0xbf,0x02,0x54,0xa9,0x1d,0x88,0x84,0xe3,0x33,0xa6,0x19,0xc6,0xe2,0x31,0xdc,0x70,0xbd,0x6d,0xb3,0x49,0xff,0xc6,0xd1,0x07,
+  0xbf,0x83,0xfd,0x18,0xbe,0x7d,0x1a,0xce,0x39,0xf5,0x77,0x5c,0x86,0xf4,0x57,0xc7,0x82,0xd7,0xfb,0x73,0xc1,0x70,0x49,0x3d,
+  0x37,0xbb,0xcd,0x80,0x95,0x79,0x0f,0x0e,0x58,0x99,0xef,0xe3,0x2c,0xc7,0xe0,0xa8,0x8b,0x8d,0xa6,0xba,0x6d,0x48,0xc1,0x41,
+  0xb0,0x7f,0x3b,0x4a,0x6f,0xa0,0x73,0x62,0x92,0x7d,0x34,0x4d,0xe8,0x14,0x3c,0x04,0x8f,0x01,0x09,0x56,0xf5,0x7e,0x8a,0xfe,
+  0xa8,0x9b,0x57,0x45,0xde,0x79,0x8c,0x4e,0xc6,0x6b,0xc3,0xe4,0x52,0xa7,0xae,0xdd,0x37,0x49,0x10,0x96,0x1c,0xb6,0x52,0x18,
+  0x8a,0x0c,0xbc,0x59,0xa6,0xb7,0xee,0xe9,0x34,0x53,0x1f,0x04,0x24,0x5c,0x23,0x34,0x79,0x7a,0x2c,0xf1,0x51,0xf6,0xcc,0xf8,
+  0x6e,0x20,0x58,0xdf,0xb5,0xe7,0x1c,0x33,0x2f,0x48,0xfb,0x80,0xb2,0xd5,0x31,0x82,0x89,0x15,0xa9,0xad,0x8b,0xaf,0x66,0x1c,
+  0x2b,0x74,0x92,0xa1,0x68,0x79,0x75,0x34,0xd3,0x98,0x2a,0x1c,0x15,0x98,0x3f,0xd6,0xf2,0x9e,0x3c,0xc5,0x0c,0x36,0x8b,0x19,
+  0xc0,0x7a,0x1d,0xaf,0xf0,0xef,0xfa,0x31,0x5f,0xc3,0x62,0xb6,0x7a,0xa4,0x1f,0x59,0x6c,0xfe,0xb2,0x98,0x66,0x3e,0x14,0x4e,
+  0xdc,0x9f,0x50,0x8c,0x83,0x27,0xab,0xc8,0x15,0xbe,0x3d,0xac,0xbc,0x0e,0x4e,0x83,0x65,0xdc,0x04,0x40,0x1b,0x08,0x78,0x55,
+  0xf0,0x0a,0x59,0x96,0x1e,0x7f,0x2a,0x01,0x45,0x32,0xb8,0x2f,0xf1,0x2e,0xae,0xd2,0x9f,0xa2,0x28,0x44,0x08,0xe6,0x5d,0x88,
+  0xa5,0x33,0xaf,0xa1,0x73,0xc5,0xb9,0x35,0x34,0xfb,0xcd,0xa6,0x36,0xcf,0x82,0x66,0x20,0xde,0x14,0x16,0x6f,0xf7,0xf9,0x44,
+  0xed,0xcf,0x9e,0x43,0x7d,0x41,0x81,0x81,0x38,0xb7,0x9f,0x03,0x57,0x06,0x97,0x1f,0xd3,0xbe,0x5e,0xae,0x86,0xbc,0x74,0xfd,
+  0x6d,0x7c,0x1b,0xdc,0x87,0x3d,0xef,0x76,0xbc,0xe1,0x99,0x80,0x1b,0xd1,0xce,0x4c,0x57,0x42,0x1f,0x4f,0xc0,0x8c,0x55,0xfc,
+  0x64,0x66,0x17,0xc2,0x52,0xb4,0x42,0x38,0x13,0x69,0x4a,0x7f,0x06,0xdf,0x90,0x75,0xb7,0x36,0xe6,0xd7,0xff,0x35,0x15,0xab,
+  0x41,0x5d,0x22,0xd0,0x79,0x2d,0x6c,0x8e,0x62,0xcf,0x1a,0x3a,0xbc,0x0f,0xda,0xc4,0xcd,0x7f,0x05,0xcc,0xd5,0x52,0xfd,0x6f,
+  0x98,0x5c,0x7d,0xb9,0x4e,0xe5,0xf7,0x9d,0xc2,0x2c,0xbe,0x93,0x7a,0x06,0xfd,0x17,0x38,0x14,0x8a,0x96,0xd0,0x04,0x43,0xf7,
+  0x76,0xd1,0x07,0x4f,0x30,0xc8,0xf8,0x78,0x42,0x84,0x62,0x03,0x70,0x7c,0x63,0xdd,0x62,0x68,0x77,0x98,0xaf,0x37,0x5d,0x1c,
+  0xff,0x01,0x6f,0x3f,0x7e,0x7b,0x59,0x10,0x00,0x00
+};
+const char WWW_INDEX_CSS_PATH[] PROGMEM = "/index.css";
+const char WWW_INDEX_CSS_TYPE[] PROGMEM = "text/css";
+const char WWW_INDEX_CSS_ETAG[] PROGMEM = "\"d91428d37af9718a\"";
+const char WWW_INDEX_CSS_CACHE[] PROGMEM = "public, max-age=31536000, immutable";
+
+// index.js: 10575 bytes minified, 3798 bytes gzipped
+const uint8_t WWW_INDEX_JS[] PROGMEM = {
+  0x1f,0x8b,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0x03,0xa5,0x5a,0x79,0x73,0xdb,0x36,0x16,0xff,0x9f,0x9f,0x02,0x66,0xbb,0x2d,
+  0x35,0x96,0xa8,0xcb,0xf2,0x95,0xc8,0x99,0xc6,0x49,0xb7,0xdd,0x4d,0xd2,0x4c,0xdc,0x4c,0x67,0x47,0xe3,0x4d,0x28,0x11,0x92,
+  0x18,0x53,0xa4,0x96,0x87,0x15,0xd5,0xd5,0x77,0xdf,0xdf,0x7b,0x00,0x49,0x50,0x92,0x8f,0x4c,0x7d,0x88,0x24,0x80,0x77,0xe2,
+  0x9d,0xa0,0x1c,0x2f,0x5d,0x47,0x13,0xe1,0x34,0xc4,0xf0,0x42,0xdc,0x59,0x93,0x38,0x4a,0x33,0x81,0xcf,0x69,0x30,0xfb,0x67,
+  0x12,0xe7,0xcb,0x54,0x0c,0x31,0x9c,0x2e,0xa5,0xf4,0xcf,0xc5,0xa8,0xdb,0x14,0xbd,0xa6,0xe8,0x37,0xc5,0x51,0x53,0x0c,0xae,
+  0x9b,0x56,0x9a,0x79,0x59,0x9e,0x62,0xc2,0x1a,0xd9,0x3f,0x27,0x52,0xda,0x4d,0x61,0xbf,0xcc,0xd3,0x35,0x5d,0x5f,0xbd,0x7b,
+  0x65,0x63,0xc9,0xc8,0xfe,0x18,0xdd,0x44,0xf1,0x2a,0xa2,0xb1,0xf7,0x5e,0x92,0xad,0x0f,0xe8,0xee,0x32,0x4f,0xb3,0x78,0x41,
+  0x0b,0xf0,0xb7,0x88,0x7d,0xa9,0x90,0xc4,0xd3,0x29,0xcd,0xa6,0x71,0x18,0xf8,0x74,0x33,0x4e,0xa4,0x97,0xcd,0xe9,0x6e,0xe1,
+  0x25,0xff,0xcb,0x41,0x81,0x51,0x66,0x73,0x0c,0xcb,0x84,0xc6,0x13,0x2f,0x88,0xc6,0xf1,0xca,0xb8,0xfd,0x54,0x2c,0x35,0x86,
+  0x0a,0x00,0x86,0x4e,0x97,0x5e,0x72,0x13,0xf2,0x7c,0xb6,0x0a,0x22,0x7d,0x3b,0x0d,0x12,0xbe,0x2e,0x64,0x26,0x63,0xbd,0xd2,
+  0xcb,0xfd,0x20,0xd6,0x4c,0x6e,0x9e,0x69,0xed,0x78,0xcb,0x25,0x2b,0x65,0x99,0xc4,0x5f,0xd7,0xe7,0x02,0x18,0xfc,0x78,0xe5,
+  0x86,0xf1,0xc4,0x0b,0xaf,0xb2,0x38,0xf1,0x66,0xd2,0x9d,0xc9,0xec,0xd7,0x4c,0x2e,0x1c,0xfb,0xd3,0x27,0x99,0x2e,0x4f,0x7b,
+  0xc7,0xc7,0xef,0x69,0xb1,0xdd,0x10,0x7f,0xfd,0x25,0x6c,0x5b,0x29,0x0e,0x22,0xdf,0x6d,0x9a,0x96,0x52,0x36,0xee,0xad,0x1b,
+  0xb9,0x86,0x2e,0x7f,0x1b,0x7f,0x91,0x93,0xcc,0xa5,0x07,0xc7,0xdc,0x88,0x46,0xd3,0x9a,0xf1,0x8d,0x02,0xdb,0xb0,0xda,0xbc,
+  0x50,0x3d,0xf9,0x72,0x1c,0xe7,0xd1,0x84,0x50,0x02,0x61,0x18,0x27,0xe7,0xe2,0x15,0x28,0xb8,0x50,0xbc,0x03,0xc0,0xdb,0x40,
+  0xae,0x96,0x71,0x92,0x9d,0x8b,0x2e,0x43,0x9a,0xcc,0x12,0xc8,0x3c,0x4e,0xb3,0xc8,0x5b,0xe0,0xbe,0xe2,0xf8,0x17,0x3d,0x06,
+  0x6e,0x27,0xbc,0x59,0x57,0x7a,0xb3,0xab,0x25,0x97,0xc6,0xb8,0xcd,0x88,0x4b,0x25,0x4d,0x42,0xe9,0x25,0xaf,0xe4,0xd4,0xcb,
+  0xc3,0x0c,0xda,0x2a,0xec,0xcb,0x8f,0x27,0xf9,0x42,0x46,0x99,0x3b,0x8e,0xfd,0xb5,0x9b,0xc8,0x45,0x7c,0x2b,0x2f,0xe7,0x41,
+  0xe8,0x3b,0xe5,0x0c,0xb6,0x2e,0x59,0x5f,0xc9,0x10,0x4a,0x88,0x13,0xc7,0xfe,0xce,0x57,0x48,0xec,0x46,0xe3,0x99,0xb1,0x07,
+  0xf9,0x8c,0x16,0xbf,0x04,0x96,0x7b,0xb1,0x4f,0x42,0x2f,0x4d,0xdf,0x04,0x69,0xe6,0x7a,0xbe,0xef,0xd8,0x00,0xcc,0x60,0x0d,
+  0x32,0x69,0x4d,0xc3,0x1c,0xd6,0x05,0x74,0xf5,0xf5,0xd8,0x57,0x19,0xf9,0x8e,0xe5,0xba,0xee,0x38,0x07,0x4b,0x97,0xf1,0x62,
+  0x19,0x47,0x98,0x4e,0x1d,0xeb,0xf3,0x73,0x18,0x90,0x2f,0x13,0xc1,0x48,0x87,0x15,0x32,0xfb,0xc2,0x7a,0x3e,0xef,0x8a,0xc0,
+  0x1f,0xda,0x59,0x90,0xc1,0x92,0x2e,0x5e,0x5f,0xbd,0x27,0xdd,0x08,0xa5,0x16,0xf1,0x26,0x98,0xcd,0xb3,0xe7,0xed,0x79,0x17,
+  0x0b,0x3d,0x4b,0x83,0x8f,0xb3,0x48,0xe0,0xbf,0x15,0xe7,0x59,0x08,0x2c,0x2d,0x1f,0x06,0x29,0x66,0x41,0x36,0xcf,0xc7,0xb6,
+  0x35,0x4f,0xe4,0x74,0x68,0xcf,0xb3,0x0c,0x5b,0xdd,0x6e,0xab,0x51,0x77,0x12,0x2f,0xda,0x1f,0xe2,0xb1,0x4c,0xb2,0xb7,0x93,
+  0x0f,0x70,0xc6,0xb6,0xde,0x82,0x4f,0xca,0x05,0x3f,0x85,0x44,0xc6,0xb6,0x40,0x24,0xbd,0x9d,0x89,0xaf,0x8b,0x30,0x4a,0x15,
+  0x0e,0xa0,0x58,0xad,0x56,0xee,0xaa,0xef,0xc6,0xc9,0xac,0xdd,0xeb,0x74,0x3a,0x6d,0xac,0xb0,0x61,0xb6,0x7e,0x36,0x1f,0xda,
+  0xdd,0x63,0x5b,0xcc,0x25,0x01,0xab,0xfb,0x69,0x10,0x86,0x10,0x2f,0x4f,0x12,0x08,0x7e,0x49,0x96,0x64,0x17,0x32,0x8f,0x03,
+  0x31,0x0e,0x5a,0x9a,0x4b,0x41,0x26,0xf5,0x32,0xfe,0x3a,0xb4,0x3b,0xa2,0x23,0xba,0xc7,0xf8,0x23,0x55,0x2c,0xe1,0xad,0x8c,
+  0xa3,0x95,0xe4,0xa1,0x1c,0xda,0xf2,0x56,0x46,0xb1,0xef,0xdb,0x02,0xfa,0x79,0x7b,0x2a,0x3a,0x97,0x7d,0x77,0x80,0x0b,0x7e,
+  0xf5,0xcd,0xe9,0x84,0x6f,0x8f,0x44,0xcf,0xed,0x9d,0x89,0x63,0x77,0xd0,0x17,0x03,0xf7,0xe8,0x44,0x9c,0xb8,0x83,0x33,0xf7,
+  0xc8,0xed,0xe0,0x3a,0x68,0xb9,0x5d,0x75,0xe9,0x03,0x02,0x0f,0x67,0x2d,0xb7,0xd3,0x6d,0xb9,0xa7,0x3d,0xbe,0x76,0xdd,0xa3,
+  0xb3,0x56,0x0f,0x77,0x6e,0xff,0x04,0xd7,0x41,0xbf,0xa5,0x06,0x8e,0xb1,0xec,0xec,0x08,0x4b,0x70,0xed,0xd1,0xe0,0xa9,0x7a,
+  0x06,0x58,0xd7,0xed,0x62,0xa0,0x87,0x81,0x2e,0xb0,0x1e,0xe3,0x3a,0x50,0xb8,0x00,0xed,0x1e,0xf7,0xe9,0x56,0x74,0xdd,0xce,
+  0x29,0xb1,0xd8,0x05,0x30,0x60,0xdc,0x93,0x1e,0xdd,0xd2,0xf8,0xe9,0x09,0xfe,0xc0,0x6f,0x1f,0x6b,0x8f,0xc1,0x21,0x41,0x33,
+  0x32,0x4c,0x0c,0x88,0x1f,0x0c,0x75,0xdd,0x13,0x0c,0xf4,0x5a,0x58,0x42,0x24,0xcf,0xd4,0x4d,0xdf,0x3d,0x1b,0x90,0x04,0x58,
+  0xd8,0xa7,0x85,0x10,0x11,0xdc,0xf4,0x98,0x8b,0x0e,0xaf,0x77,0xfb,0xc7,0x84,0xa0,0x47,0x8f,0x18,0xef,0xb1,0xaa,0xdc,0x63,
+  0xd0,0x00,0x69,0x50,0x21,0x4e,0x08,0x63,0x97,0x18,0xeb,0x63,0x7d,0x0f,0x9c,0xd0,0x27,0xa4,0xa0,0x7d,0x00,0x3c,0x04,0x16,
+  0x3d,0x41,0x13,0x5d,0x52,0x06,0xb0,0xb1,0x72,0x49,0xf0,0xe2,0xea,0x1e,0x1d,0x61,0x12,0xbf,0xd8,0x36,0xf7,0x8c,0x88,0x09,
+  0x22,0x06,0xee,0xdd,0xc1,0x31,0xad,0xeb,0x12,0x46,0x5e,0xdf,0x1d,0xf0,0x5e,0xb1,0x48,0x90,0xba,0xef,0x9e,0x0c,0x48,0x96,
+  0x81,0x20,0x59,0xb0,0x65,0x6e,0x6f,0x80,0xdd,0x73,0x4f,0x78,0x0f,0xb1,0x15,0x8a,0x0b,0x52,0x0a,0xeb,0xf0,0x4c,0x29,0x13,
+  0x74,0x49,0x8e,0x1e,0x48,0x62,0x77,0xb1,0xcb,0x03,0xec,0xe5,0x4f,0xa7,0x98,0xea,0x09,0xf5,0xd9,0x11,0xda,0x8e,0x60,0x10,
+  0xad,0x23,0xf7,0x88,0x54,0x37,0x38,0x6d,0xf1,0xef,0x9f,0x76,0x1b,0xa6,0x45,0x66,0x4b,0x17,0x8f,0x3e,0x94,0x37,0x5e,0x7c,
+  0x6e,0xc2,0x33,0x17,0x70,0x44,0x8c,0xf9,0xc1,0xed,0x7e,0xef,0xec,0x5d,0x70,0x44,0x04,0x50,0x0f,0x8f,0x41,0xb4,0xcc,0x33,
+  0x91,0xad,0x97,0x92,0xd6,0x99,0xf6,0xbd,0x0c,0x26,0x37,0x00,0x61,0x5f,0xd6,0x33,0xb7,0x5e,0x98,0x63,0xdd,0x77,0x53,0xfe,
+  0x21,0x6c,0x6d,0x90,0x79,0x98,0xd8,0x38,0x21,0x6f,0x8a,0x64,0x9a,0xee,0xa1,0x98,0x78,0xd1,0x4c,0x96,0x14,0xa7,0x71,0xb2,
+  0x68,0xe9,0x21,0xa2,0x5a,0x81,0xda,0x62,0x11,0x44,0xf0,0x2d,0x5c,0x3d,0xf8,0x58,0x77,0xd0,0x31,0x88,0xb7,0x59,0x62,0x96,
+  0xdd,0xe0,0x83,0xb3,0x81,0xc2,0x43,0x31,0x21,0x98,0xbc,0xf4,0x26,0x37,0x7e,0x12,0x2f,0x6d,0x91,0xc4,0xe4,0x8b,0x7e,0xe0,
+  0x85,0x31,0x3c,0xdf,0x4b,0x02,0xaf,0x15,0x7a,0x63,0x19,0x86,0xd2,0x1f,0xaf,0xb7,0x97,0xbf,0xa1,0x19,0xbd,0x6a,0x1e,0xf8,
+  0xbe,0x04,0x1f,0x59,0x92,0x4b,0xbb,0x2e,0x36,0x93,0x6b,0x69,0x9c,0xfb,0xa6,0x48,0x2f,0x88,0x21,0x7b,0xe7,0xd4,0xf6,0xb1,
+  0xc2,0x06,0xf5,0x19,0x15,0x44,0xf7,0x48,0xa1,0xd8,0xba,0x40,0x50,0x5e,0xe4,0x51,0x30,0xc1,0x54,0x1c,0x89,0xd7,0x49,0xc2,
+  0x1b,0x3b,0xd8,0xbb,0x33,0x0a,0x23,0xc5,0x76,0x0e,0x4d,0x17,0x3f,0x45,0x42,0x12,0x80,0x88,0x27,0x1c,0xe0,0x7c,0xb1,0x42,
+  0xea,0x91,0xc2,0xcb,0x90,0xab,0x97,0x59,0x10,0xcd,0x44,0x16,0xa3,0xf8,0x29,0x28,0x48,0x04,0x49,0x84,0x33,0xd4,0x0e,0xc2,
+  0x97,0xb7,0xc1,0x44,0xba,0xcf,0xdb,0x4b,0xc6,0xf4,0xd6,0xbb,0x91,0x22,0xcd,0x13,0x29,0x82,0x4c,0x04,0xa9,0x58,0xc6,0x2b,
+  0x49,0xf8,0xc0,0x92,0x17,0xf9,0x54,0x3f,0x45,0x48,0x5f,0x18,0x00,0x3e,0x02,0x4f,0x91,0x47,0x45,0x24,0xb3,0x55,0x9c,0xdc,
+  0x68,0x24,0xf7,0xb1,0x3b,0x8d,0xe3,0x4c,0xa9,0x66,0x9c,0x67,0x19,0x10,0x2a,0xc3,0x51,0x0f,0x4a,0x31,0xc8,0x0f,0x89,0x4c,
+  0xe7,0x55,0x60,0xd6,0xd9,0x64,0x99,0x04,0x28,0x7d,0x20,0xec,0x07,0xb5,0xe0,0x79,0x5b,0x41,0x19,0x96,0xb3,0x7b,0xf9,0x6c,
+  0x35,0x2c,0xa4,0xc2,0x39,0xf8,0x0e,0xe5,0xc7,0xa5,0x0f,0xb1,0x29,0xf3,0x3b,0x8d,0x22,0xd5,0x6a,0x6a,0x2f,0x41,0x64,0x28,
+  0xee,0xcd,0xd2,0x05,0x4f,0x25,0x18,0x4b,0xf3,0x10,0xc4,0x96,0x91,0x02,0x10,0x09,0xd8,0xad,0x5c,0xe0,0x21,0x58,0xc3,0x51,
+  0x76,0xe0,0x28,0xdb,0xbf,0x46,0xda,0xc9,0x28,0xf5,0x4b,0xf8,0x25,0x52,0xff,0x9c,0x7d,0xac,0x29,0x94,0x94,0x97,0xfc,0xf8,
+  0xb2,0x84,0x78,0x0a,0x0a,0x76,0xe2,0x12,0xc3,0x9b,0xe0,0xb6,0x0e,0x5f,0x29,0x69,0x1f,0xf9,0x10,0x91,0xa5,0x84,0xd5,0x9b,
+  0xa3,0x89,0x16,0x6a,0xba,0xb3,0x62,0x54,0x1f,0xe7,0xba,0x94,0xe1,0xd1,0xed,0x02,0x26,0x9d,0xa3,0xcc,0x45,0x31,0x37,0x09,
+  0xe3,0x54,0xde,0xb7,0x52,0x95,0x54,0xd5,0xe2,0xcd,0x6e,0xd1,0xf4,0x16,0xd1,0xc3,0x28,0x9a,0x98,0x0b,0x35,0x74,0x9f,0xbe,
+  0x69,0xba,0x50,0xb4,0x2a,0x49,0xb9,0x3c,0x05,0xd8,0xd2,0xd1,0x35,0xea,0xbf,0xe5,0xba,0xd6,0x42,0x60,0x77,0x11,0x4d,0x7d,
+  0x20,0xfd,0x29,0x49,0xbc,0xb5,0x1b,0xa4,0x7c,0xad,0x55,0xb4,0xa3,0x12,0xf4,0x7a,0xd4,0xb9,0x2e,0x2d,0x67,0x54,0x46,0xd4,
+  0x6b,0x80,0xef,0x29,0xc5,0xf6,0x05,0x5f,0xf1,0xfd,0x5d,0x41,0xf2,0x85,0xb0,0xf5,0xad,0x2d,0x50,0xad,0xda,0x1b,0xcc,0x95,
+  0x94,0x36,0x3a,0x4a,0x9b,0x43,0x3a,0x4e,0x17,0xee,0xf0,0xac,0x54,0x89,0x2e,0x09,0x55,0x81,0x5a,0x92,0x2a,0x19,0x55,0xe5,
+  0x38,0xe4,0x02,0x9b,0x9a,0xa2,0xf5,0x42,0xdc,0x23,0xa1,0x75,0x2e,0x46,0xf7,0x4c,0x5d,0xd7,0x34,0x3b,0xdb,0x9e,0x66,0xeb,
+  0x28,0xa9,0x37,0xad,0x24,0x5e,0x51,0xcb,0xa5,0x5a,0x92,0x92,0x07,0x17,0xc9,0xe4,0xb5,0x37,0x99,0x3b,0x0e,0x42,0xc1,0x87,
+  0x78,0xd5,0x44,0xd4,0x5f,0xbd,0xcb,0x17,0xb5,0x5d,0x19,0x61,0xec,0x7e,0xa5,0x1a,0xd5,0x69,0x8b,0xf1,0x8a,0xc4,0x43,0xff,
+  0x23,0xa6,0x39,0xea,0x39,0xae,0x17,0x5b,0xe9,0x42,0x8c,0xd1,0x3c,0xdc,0xd8,0x96,0xca,0x29,0xbc,0xcc,0xb6,0x28,0x2a,0xd5,
+  0x94,0x6c,0x5d,0x18,0xea,0x2c,0x79,0xaf,0xe9,0x13,0xac,0x34,0x1e,0x16,0xdc,0x25,0x49,0xdd,0x65,0x9e,0xce,0xf5,0x62,0xdd,
+  0x5a,0x10,0x38,0xca,0xd3,0x7d,0x72,0x50,0xed,0xce,0xe2,0xbb,0xd3,0xd0,0x83,0xa5,0xc3,0x3e,0xe3,0x25,0xa5,0x8a,0xc2,0x3e,
+  0x47,0x10,0xb5,0x9e,0x90,0xa9,0xc3,0x33,0x22,0x69,0x6b,0x32,0x97,0x90,0x0f,0xce,0x92,0xc5,0x48,0x05,0xcb,0x10,0xed,0xe0,
+  0x90,0xfb,0x52,0x95,0xa2,0xb1,0xc2,0x94,0x14,0x0f,0x25,0x81,0x8d,0x2d,0xa8,0x61,0xda,0x52,0x85,0x40,0x48,0xf5,0x5a,0xba,
+  0x92,0xa8,0xad,0x86,0x8e,0x98,0x95,0x0b,0x9b,0x73,0x39,0xa7,0x64,0xf1,0x40,0x87,0x80,0xea,0x3c,0x4e,0x1e,0x63,0xe1,0xc2,
+  0x7c,0x7a,0xde,0x66,0xa4,0x54,0x2b,0x5c,0x73,0x98,0x87,0x1e,0x8b,0x3e,0x07,0xaa,0x2a,0x34,0xf9,0xd8,0x3e,0x30,0x12,0x0a,
+  0xc8,0x05,0x80,0xe5,0xa2,0xc6,0x47,0x9a,0x72,0x9c,0x80,0xb5,0x7a,0xe0,0x04,0xe2,0x1f,0xa2,0xd7,0x68,0x58,0x08,0x40,0x7e,
+  0x3e,0x91,0x8e,0xe5,0x78,0x93,0x49,0x53,0x30,0x24,0x2f,0x71,0xee,0x04,0x28,0xf2,0xe0,0x88,0x47,0xdd,0x4c,0x7e,0x45,0x87,
+  0xc1,0x45,0xc2,0xf5,0xb9,0x5a,0x29,0x36,0x08,0x59,0x4f,0x61,0x05,0x6d,0xf4,0xdd,0xa6,0x14,0xe8,0xb1,0x80,0xff,0x92,0xd3,
+  0xe0,0x25,0x85,0x61,0x23,0x5c,0x51,0x3f,0x89,0xff,0x60,0x2a,0xaa,0x41,0x31,0x1c,0x0e,0x39,0x7c,0x50,0x47,0xdb,0xa8,0xfc,
+  0xc6,0xec,0x80,0xef,0x71,0x20,0xde,0x4a,0x4b,0x59,0x15,0x89,0x66,0x5b,0x66,0x95,0x47,0x3e,0x00,0x97,0xb1,0xd1,0xf9,0xaf,
+  0x55,0x31,0x96,0x2e,0x43,0x6f,0x7d,0x2e,0x22,0x60,0x78,0xa6,0x3c,0x48,0x11,0x69,0x29,0xea,0xad,0x69,0x20,0x43,0xdf,0xb6,
+  0x50,0xff,0x85,0x32,0x9a,0x51,0xaf,0x76,0xdc,0xb1,0x2d,0x00,0x4d,0xe4,0x3c,0x0e,0x51,0x3e,0x0d,0xed,0xd7,0x50,0x5e,0x22,
+  0x3c,0xa1,0x00,0x85,0x02,0x84,0x96,0x6d,0xab,0xad,0x3d,0xcf,0x60,0x7b,0x8f,0x9a,0x10,0xc4,0xe1,0xbd,0x65,0x5a,0x34,0x16,
+  0xd7,0x2d,0xc2,0x44,0x43,0x56,0x60,0x3c,0x6e,0xd1,0x60,0x33,0xc7,0x92,0x87,0x0e,0x45,0x18,0x73,0x6d,0xc6,0x44,0x71,0x7f,
+  0xc0,0x98,0xd4,0xf9,0xdb,0xf0,0xee,0x95,0xc9,0x2d,0x88,0x82,0xec,0x3d,0x57,0xf0,0x5b,0xb9,0x6d,0x59,0x0c,0xde,0x5b,0x4d,
+  0xa8,0x62,0x5f,0x8b,0xac,0x96,0x3f,0x5a,0x01,0x70,0x6b,0xac,0x0a,0x89,0xc7,0x00,0xb7,0xab,0x0f,0x82,0x7c,0x85,0x5d,0x37,
+  0xb9,0x87,0x4f,0xf9,0x35,0xce,0xcd,0xf3,0x13,0xaa,0xc5,0x8c,0x03,0x0f,0xe3,0x91,0x52,0xb9,0x53,0x56,0x6f,0x1f,0x64,0x1a,
+  0xfc,0x29,0xe9,0x59,0xab,0x3f,0x8e,0x12,0x1e,0x02,0x5e,0x73,0x05,0x6c,0xbe,0x54,0x96,0x09,0xcd,0x75,0x89,0x03,0x1f,0x46,
+  0xed,0x4b,0x89,0x44,0xb1,0xb2,0xc1,0x00,0x6a,0xd8,0xc8,0xd1,0x55,0xed,0x15,0xc2,0xbf,0xcc,0x14,0xf3,0xd3,0x3c,0x9a,0x70,
+  0x21,0xfe,0xb3,0x43,0x9d,0x7f,0x53,0x50,0xb1,0x4d,0x6e,0x93,0xc8,0x2c,0x4f,0x22,0x6d,0x06,0x88,0x16,0x92,0x10,0x5a,0x9f,
+  0xbf,0xbf,0x63,0x4d,0xd1,0x59,0xd8,0xe6,0xfb,0x3b,0x02,0xd9,0x20,0x34,0x11,0x10,0xb2,0xf6,0x9d,0x58,0xc8,0x6c,0x1e,0xfb,
+  0xc8,0xd9,0x4b,0x54,0xa0,0xb6,0xc2,0x76,0x2e,0xfe,0x75,0xf5,0xdb,0x3b,0x37,0xcd,0x12,0xd4,0xe7,0xc1,0x74,0xed,0x28,0x12,
+  0x1b,0x71,0xce,0x11,0x40,0xf3,0xe6,0x24,0xcc,0x6c,0xe2,0x7e,0x49,0x63,0x68,0xa4,0x1c,0xfe,0xa2,0x62,0x4f,0x49,0x55,0xfc,
+  0xf0,0x03,0x25,0xe8,0x14,0xc9,0x0b,0x26,0x38,0xc3,0x3c,0x1f,0xc9,0x7d,0xa9,0x84,0x96,0x7a,0x03,0x94,0x52,0xb8,0xc1,0x20,
+  0x1d,0x65,0x73,0x44,0x1a,0x21,0x55,0xc8,0xd8,0x54,0x82,0xd7,0x94,0xe2,0x54,0x11,0x23,0x46,0x75,0xc8,0x35,0x55,0x45,0x1a,
+  0x74,0x0c,0xb7,0x20,0x68,0x57,0xad,0x2a,0x8c,0x20,0x65,0x24,0x80,0x89,0xe4,0x4a,0xfc,0x21,0xc7,0x1a,0x29,0xb4,0xa6,0xd6,
+  0x21,0xb6,0xb2,0xfb,0x3b,0xed,0xff,0xd2,0xc9,0x4e,0xbb,0x29,0xec,0x15,0xa2,0xd4,0xa6,0xbd,0x4a,0x3f,0x83,0x2b,0x05,0x8e,
+  0x4d,0xa7,0x4a,0xb2,0x34,0x25,0x96,0xbd,0xc4,0x9c,0x16,0x9b,0x57,0x2e,0x5e,0xa0,0x80,0x85,0x0f,0xd2,0xfa,0x3b,0x4e,0x55,
+  0x88,0xc1,0x04,0xf7,0xd1,0x61,0xbd,0x2f,0xbd,0x24,0x95,0x0e,0x8d,0x37,0x9a,0xe2,0xa0,0xb0,0x73,0x6c,0x85,0x89,0x83,0x2b,
+  0xd2,0x2d,0xb7,0xab,0x84,0x41,0xf5,0x80,0xb5,0x32,0xfb,0x3d,0x58,0x48,0xa4,0xb3,0xba,0x1d,0x35,0x05,0x1d,0x49,0x29,0x6b,
+  0x32,0xd4,0xfa,0xc6,0x29,0x2c,0x89,0xc2,0xf3,0x41,0x85,0xd0,0x30,0xae,0xa9,0x17,0xa6,0xb4,0x21,0x06,0x39,0x37,0xa5,0xcc,
+  0xb6,0xcf,0x60,0xb8,0x46,0x67,0x30,0xea,0x65,0x6b,0xb4,0xae,0x9c,0x65,0x53,0xdc,0x34,0xc5,0xad,0x81,0xfb,0x67,0x1a,0xbb,
+  0x13,0xa3,0x1b,0x64,0xa6,0x5b,0x68,0x44,0x99,0xd3,0xc7,0xfa,0xde,0x7f,0x84,0xc6,0x38,0x76,0x34,0x39,0xb5,0x2d,0x03,0x8a,
+  0x4d,0x52,0x6c,0x9a,0x02,0xd2,0xb2,0x9b,0x97,0x01,0x89,0x88,0x56,0xc6,0x71,0xa7,0x43,0x75,0x93,0xca,0x77,0x00,0xb0,0x99,
+  0x28,0xe8,0x22,0x1f,0x01,0xd8,0x48,0x3f,0xa0,0x30,0x83,0x3b,0x50,0xe6,0xe1,0xa9,0xb2,0xa2,0x2f,0x06,0x46,0xfd,0x6b,0xd1,
+  0x16,0xdd,0x41,0xe7,0x99,0x68,0xf3,0x15,0x13,0x54,0xb6,0x89,0xaa,0xa9,0x61,0xc4,0x75,0xc6,0x1a,0xc2,0x08,0x5c,0x45,0xe8,
+  0xce,0xe2,0x5f,0xe4,0x57,0x47,0x53,0xdc,0x39,0x24,0x2d,0x3b,0x8d,0x51,0xaa,0xd3,0x01,0x25,0x4c,0x7d,0xae,0x4f,0xa5,0xb7,
+  0xe7,0xab,0xb2,0x5b,0x35,0x22,0xf6,0xb5,0x63,0x95,0x47,0xf4,0x56,0x3d,0x52,0x56,0xa8,0xf8,0x05,0x80,0xc2,0xc4,0x85,0x16,
+  0x3c,0xe5,0x69,0xd8,0xad,0x6b,0xc7,0xce,0x12,0x2f,0xa2,0x13,0x7d,0x3a,0x6b,0xd0,0x04,0xf8,0x74,0xdd,0x65,0xc5,0x40,0xa0,
+  0x42,0x7b,0x4d,0xe1,0x5d,0x97,0xe6,0xc2,0x3b,0x85,0xc2,0x5a,0xed,0x9c,0x1e,0xd8,0xda,0xc7,0x9d,0xb6,0xb0,0x50,0x51,0xb1,
+  0xc4,0x98,0x2b,0x76,0x04,0x15,0x44,0x11,0x7d,0x97,0x70,0xab,0xff,0xfc,0x36,0x9d,0x42,0xe7,0x90,0xc8,0xaa,0x4e,0xb8,0x8b,
+  0x9b,0xd7,0xa1,0xa4,0x0b,0x89,0x5b,0x57,0xb2,0x92,0xe6,0x1d,0x29,0x65,0x7b,0x0e,0x81,0x2a,0x9d,0xa0,0x90,0x08,0x7f,0x8f,
+  0x97,0xca,0x56,0x4a,0x66,0xb4,0xca,0x0e,0xa0,0xb2,0x1c,0xd9,0x64,0x8a,0x04,0xea,0x57,0x36,0x14,0xa4,0x2a,0xbf,0x83,0xfd,
+  0x03,0xb3,0x0f,0xd1,0x60,0x5c,0x2f,0x3b,0x0d,0x37,0x80,0x33,0xe7,0xbe,0x4c,0xb7,0xd1,0x96,0x69,0xe2,0x75,0x44,0xe7,0x1e,
+  0x66,0xad,0xe0,0x14,0xa8,0x1b,0x6c,0x7c,0x92,0x17,0xc0,0x2c,0x93,0x04,0x5e,0x2e,0x6e,0x83,0x34,0x18,0x07,0x61,0x90,0xad,
+  0x99,0xdb,0x72,0xad,0x0e,0x13,0x7b,0x2a,0x8c,0x5d,0x35,0xa7,0xba,0xd4,0xd8,0x16,0x75,0x58,0xbe,0x47,0x62,0xca,0x59,0x5c,
+  0x10,0x5f,0x49,0x3c,0xcc,0x66,0x21,0x2e,0x73,0x2f,0xd3,0x6d,0x8c,0x3a,0x0c,0xa1,0xba,0x61,0xa7,0x91,0x2d,0x7b,0xa7,0xed,
+  0x66,0xf6,0x09,0xb5,0xe8,0xa8,0xe0,0xca,0xec,0xe8,0x5e,0xb8,0xdc,0xf4,0x3b,0xba,0xc6,0xd4,0x16,0x51,0xec,0x9c,0xd3,0x69,
+  0x8a,0x75,0x3d,0x96,0xec,0x96,0x60,0x08,0x2e,0x99,0x97,0xa0,0x68,0x42,0xa2,0x53,0x07,0x91,0x08,0x14,0x9b,0x46,0x51,0x1b,
+  0x14,0xd1,0x94,0x38,0x2c,0xde,0xfe,0xb8,0x5b,0x25,0x12,0x29,0x9c,0x21,0x0b,0x6d,0xef,0x5d,0x48,0x69,0xa1,0x8a,0xce,0x45,
+  0x0c,0xdf,0x57,0xc1,0xa5,0xba,0x82,0x7b,0xb0,0x80,0x6b,0x2a,0x66,0x41,0xfe,0xca,0xb1,0xdb,0x4a,0x27,0xfc,0x4e,0x4f,0xbf,
+  0x26,0x2a,0xa7,0x11,0x27,0x07,0x2a,0xf4,0xef,0x2a,0xa2,0x2c,0x46,0xcc,0x90,0x5c,0x60,0x6b,0xb3,0xb3,0xda,0x65,0x50,0x56,
+  0xd7,0xf2,0x34,0xc5,0xe5,0x74,0xb4,0x4f,0xbd,0x3a,0x9b,0x17,0x87,0x1e,0xbc,0x98,0x92,0xa5,0xb3,0x6f,0xb1,0x79,0x16,0x56,
+  0x7a,0x51,0xf1,0xa2,0xec,0x91,0x12,0x77,0x47,0x41,0x05,0x9c,0xde,0x94,0xf2,0x51,0xe4,0x4c,0xe5,0x2a,0xd0,0x94,0xee,0x2a,
+  0x0a,0x64,0x37,0x24,0x73,0x31,0x50,0xc8,0x5b,0x87,0xa8,0x73,0xfe,0x10,0x36,0x9d,0x4b,0x2b,0x09,0x86,0xaa,0x38,0xa9,0x78,
+  0x51,0x8a,0x7e,0xf6,0x6d,0x5b,0x5f,0x80,0x37,0x85,0x21,0xa3,0x52,0x16,0x9f,0xe5,0x42,0x53,0x28,0x60,0x8a,0xb9,0x51,0xe7,
+  0xda,0xcd,0xe2,0x8f,0xa8,0xea,0x93,0x4b,0x0f,0x85,0x45,0x63,0x53,0xcd,0xb9,0x29,0x5c,0x06,0x9d,0x63,0xd7,0x6a,0x6c,0x7e,
+  0x4c,0x6b,0xef,0xcf,0x3e,0x1b,0x69,0x68,0xbb,0x7a,0x57,0x27,0xc6,0x0d,0xb3,0x9d,0xa4,0x2c,0x46,0xa3,0x06,0x54,0xc1,0x8b,
+  0x1e,0xdf,0xd9,0xed,0xfd,0x2d,0x62,0x65,0x7d,0x35,0x6f,0xa4,0x72,0x88,0xa2,0xfa,0x46,0xd7,0x4a,0x7b,0x62,0xac,0x5e,0x52,
+  0xc4,0xb2,0xa1,0x11,0xaa,0xf4,0xe2,0x22,0xca,0x95,0x40,0x2f,0xc4,0xc3,0x01,0xf1,0xbc,0x8e,0xd4,0x70,0x6f,0xa1,0xb7,0x32,
+  0xdd,0x0a,0x43,0x15,0xff,0x24,0xf1,0xc3,0x8d,0xee,0x13,0xa2,0x3b,0x70,0x14,0xda,0x38,0x28,0xb9,0x46,0x82,0xd2,0x21,0x06,
+  0xa5,0x75,0xcd,0xe3,0x4b,0x5a,0x86,0xcb,0xef,0x73,0xca,0x07,0x48,0x6a,0x9b,0x2d,0x89,0x81,0xc4,0x81,0xa1,0x24,0x3a,0xe4,
+  0x7c,0x3c,0x9d,0x70,0xc7,0xed,0xea,0x86,0x9b,0x72,0x86,0x3a,0xc1,0xda,0x73,0xe6,0x51,0xe4,0xc2,0xaa,0xff,0xdc,0x7e,0x87,
+  0xac,0x3a,0x74,0xce,0x69,0x64,0x74,0x10,0x47,0x20,0x05,0x48,0xc1,0x55,0xaa,0xc9,0xe6,0xdf,0xe7,0x92,0x0e,0x06,0xbe,0x95,
+  0xc9,0xe2,0xf4,0x77,0x0f,0x9f,0xd6,0x5e,0x8e,0x0c,0xfb,0xab,0x6d,0x8d,0x2a,0x02,0x51,0x0d,0x25,0xb3,0xb1,0xe1,0x05,0x9f,
+  0xbf,0xfb,0xfe,0x0e,0x23,0xea,0xe0,0x37,0x52,0xfd,0xc5,0x61,0x04,0xdf,0x8b,0xaf,0xb8,0xdc,0x76,0xba,0xc7,0x0d,0x54,0x2f,
+  0x3e,0x64,0x4a,0x32,0xa7,0x87,0xa8,0xdf,0xb1,0x1b,0x0d,0xf7,0x4b,0x8c,0x36,0xd5,0x46,0xa7,0xf2,0xb9,0x46,0x64,0x9a,0xc4,
+  0x0b,0x22,0x33,0x97,0x5f,0x0d,0x1a,0xf4,0x25,0x93,0x3e,0x7d,0xbd,0x44,0x51,0x51,0x07,0x4c,0xdc,0x86,0xfc,0x1a,0x65,0xb4,
+  0x56,0xc7,0x89,0xa0,0x29,0x02,0x71,0x28,0x7a,0xe8,0x4b,0x40,0x75,0x6f,0x36,0xad,0x7a,0xf4,0xfb,0x93,0xa9,0xd1,0xd2,0xe8,
+  0x3a,0x9d,0x6b,0x09,0x3f,0x8e,0x7e,0xcc,0x44,0x08,0x27,0xa7,0xf3,0x47,0xe9,0xeb,0xd0,0x9a,0x0a,0x52,0x30,0xbf,0xd3,0xd1,
+  0xe7,0x0a,0x39,0x37,0xee,0x79,0x5a,0x7e,0x75,0x46,0x17,0x9d,0xd0,0x5d,0x21,0x9f,0xb2,0xfe,0xa6,0x38,0xdc,0x57,0x4e,0x5e,
+  0x2b,0x3f,0x7e,0x53,0xf4,0x12,0xe0,0xaa,0xee,0xb6,0x0a,0x6f,0x84,0xee,0x73,0x68,0x7c,0xa7,0x43,0x41,0xd1,0x68,0x4b,0xd4,
+  0x33,0x3b,0x23,0xb9,0x10,0xbd,0x41,0x67,0x37,0xeb,0x6b,0xe6,0x00,0xa6,0x72,0x4b,0xe9,0xab,0x15,0xf1,0x5a,0x3f,0xfd,0x91,
+  0xfa,0x80,0x4e,0x43,0x15,0x76,0x1d,0x81,0xbc,0xc0,0xef,0xc5,0x52,0x2a,0xb0,0x60,0x44,0x79,0xe8,0x93,0x96,0x94,0x6a,0x4c,
+  0xa5,0x30,0xb2,0x7d,0x79,0xbd,0x3c,0xfc,0x78,0xea,0x86,0xe8,0x26,0xef,0xef,0x29,0xf7,0x60,0x5b,0xbb,0xdf,0x24,0xfb,0x5e,
+  0x39,0xb6,0x5e,0x21,0xed,0x8a,0x73,0x6e,0xb4,0x5e,0x85,0x68,0x25,0x2f,0xd5,0xd4,0xb9,0x38,0x34,0xd7,0xed,0xe3,0xae,0x36,
+  0x6f,0x36,0xa2,0x3b,0x5c,0xd5,0x5f,0x4b,0x3d,0x8d,0xa7,0x87,0xd9,0x79,0xb6,0xaf,0x34,0x53,0xa7,0x4c,0x80,0x25,0xf7,0x80,
+  0xdf,0xcf,0x66,0xdc,0xe3,0x76,0x94,0xb2,0xb7,0xfb,0xc5,0x00,0xf7,0x7f,0xd0,0xcb,0x03,0xf1,0x5c,0x9c,0x76,0x3a,0x85,0x1e,
+  0x6a,0x86,0x59,0x7c,0x3f,0x69,0xc7,0x62,0x8b,0x09,0x76,0x4d,0x26,0x74,0x78,0xc8,0xc6,0x38,0xf5,0xa2,0xc9,0x5a,0x74,0x48,
+  0x0b,0x46,0x04,0xfe,0x66,0xa4,0x87,0x87,0x1a,0xad,0x81,0xb4,0xab,0x73,0xa5,0x9e,0xd9,0x0a,0xda,0x0f,0xf7,0x0b,0xfb,0x72,
+  0x2c,0x7d,0x77,0xce,0xae,0xaa,0xab,0xc7,0xdf,0x78,0x94,0xd8,0x93,0x9d,0xd7,0x38,0xf7,0xe7,0x70,0xce,0x8d,0xc5,0xda,0x47,
+  0x1a,0x97,0x3d,0xa9,0x63,0x74,0x8f,0x8a,0x5e,0x94,0xbd,0x36,0xb5,0xdd,0xd4,0x7e,0x53,0xcf,0xad,0xdf,0x76,0xb5,0xb2,0x98,
+  0x2a,0x39,0x23,0x0f,0xde,0xf1,0x81,0x7c,0x85,0xf5,0xa9,0x48,0xe9,0x98,0xa0,0x7c,0xed,0xd4,0xba,0x95,0x49,0x86,0x40,0x13,
+  0xf2,0x89,0x81,0x3e,0xe7,0xdd,0xb6,0xf8,0xed,0x13,0x78,0x7a,0x9d,0x51,0x3e,0x55,0x05,0xbb,0x6f,0x1e,0xfc,0x4e,0xe8,0xdb,
+  0x84,0x52,0xb7,0xdd,0x8e,0xed,0x07,0xb7,0xfc,0x2d,0x30,0x34,0xbd,0xd0,0xc5,0x2f,0xbf,0xbf,0x7d,0xc3,0xc7,0x29,0x05,0x92,
+  0x32,0x6d,0x95,0x47,0x47,0x14,0x77,0xfc,0xf2,0xad,0xc9,0xb5,0x2a,0x88,0x28,0xfe,0xab,0x3e,0x0f,0x9f,0xff,0x07,0x87,0xfa,
+  0x07,0x7c,0x4f,0x29,0x00,0x00
+};
+const char WWW_INDEX_JS_PATH[] PROGMEM = "/index.js";
+const char WWW_INDEX_JS_TYPE[] PROGMEM = "application/javascript";
+const char WWW_INDEX_JS_ETAG[] PROGMEM = "\"458f56f077c123b2\"";
+const char WWW_INDEX_JS_CACHE[] PROGMEM = "public, max-age=31536000, immutable";
+
+// index.html: 489 bytes minified, 353 bytes gzipped
+const uint8_t WWW_INDEX_HTML[] PROGMEM = {
+  0x1f,0x8b,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0x03,0x35,0x91,0x41,0x4f,0x03,0x21,0x10,0x85,0xef,0xfd,0x15,0x23,0x17,0x2f,
+  0xb6,0x6b,0xab,0xb6,0x6b,0xb2,0xd4,0x83,0xd6,0xc4,0xc4,0x44,0x13,0xf5,0xe0,0x91,0x2e,0xb3,0x05,0x4b,0x61,0xc3,0xcc,0xae,
+  0xdd,0x7f,0x2f,0x74,0xeb,0x81,0x3c,0x78,0xc3,0x3c,0xf8,0xa0,0xba,0x78,0x7a,0x7b,0xfc,0xfc,0x7e,0xdf,0x80,0xe1,0x83,0x5b,
+  0x4f,0xaa,0x2c,0xe0,0x94,0xdf,0x49,0x81,0x5e,0x64,0x03,0x95,0x4e,0x72,0x40,0x56,0x50,0x1b,0x15,0x09,0x59,0x8a,0xaf,0xcf,
+  0xe7,0x69,0x29,0xa0,0xf8,0x2f,0x78,0x75,0x40,0x29,0x7a,0x8b,0xbf,0x6d,0x88,0x2c,0xa0,0x0e,0x9e,0xd1,0xa7,0x8d,0xbf,0x56,
+  0xb3,0x91,0x1a,0x7b,0x5b,0xe3,0xf4,0xb4,0xb8,0x02,0xeb,0x2d,0x5b,0xe5,0xa6,0x54,0x2b,0x87,0x72,0x3e,0xbb,0x1e,0x83,0xd8,
+  0xb2,0xc3,0xf5,0xe6,0xe3,0xbd,0x5c,0x2c,0x97,0xf0,0xc1,0x8a,0x3b,0x82,0x57,0xbb,0x33,0x5c,0x15,0x63,0x6d,0x52,0x39,0xeb,
+  0xf7,0x60,0x22,0x36,0x52,0x58,0xaf,0xf1,0x38,0xab,0x89,0x1e,0x7a,0xa9,0xef,0xe7,0xb7,0x8b,0x52,0xdf,0xac,0x54,0x73,0xbf,
+  0x9a,0x97,0x4a,0x40,0x44,0x27,0x05,0xf1,0xe0,0x90,0x0c,0x22,0x8f,0x27,0x14,0x67,0x96,0x6d,0xd0,0x43,0x12,0x6d,0x7b,0xb0,
+  0x5a,0x0a,0x8d,0x8d,0xea,0x1c,0x67,0xd8,0x76,0xfd,0xd2,0xc0,0x10,0xba,0xcb,0x88,0x40,0x88,0xd6,0xef,0x80,0x8d,0x25,0x38,
+  0x20,0x91,0xda,0x25,0x2f,0x24,0x5c,0x93,0x6d,0xa3,0x08,0xb6,0x31,0xec,0xd1,0xcf,0xaa,0xa2,0x3d,0xb5,0xbe,0xb5,0xe8,0xd3,
+  0x76,0xcc,0xf4,0x14,0x1c,0x02,0x87,0x1c,0x02,0xb6,0xc9,0x6e,0x4a,0x54,0x79,0xf8,0x01,0x3a,0xc2,0xa6,0x73,0x80,0x31,0x86,
+  0x48,0xe7,0xf6,0x22,0xdd,0x26,0x09,0xd5,0xd1,0xb6,0x0c,0x14,0xeb,0x7f,0xc2,0x9f,0x0c,0x78,0x7b,0x57,0x36,0x77,0xcb,0xe6,
+  0x7a,0xb5,0xaa,0xe7,0x8b,0x9b,0xed,0x42,0x00,0x0f,0x6d,0x7a,0x71,0xc6,0x23,0x17,0x3f,0xaa,0x57,0x63,0x9f,0x58,0x57,0xc5,
+  0x38,0xcb,0x89,0x67,0xcc,0xe2,0xf4,0xb3,0x7f,0xb0,0x78,0xa3,0x73,0xe9,0x01,0x00,0x00
+};
+const char WWW_INDEX_HTML_PATH[] PROGMEM = "/";
+const char WWW_INDEX_HTML_TYPE[] PROGMEM = "text/html";
+const char WWW_INDEX_HTML_ETAG[] PROGMEM = "\"c6735c8e4f9a784d\"";
+const char WWW_INDEX_HTML_CACHE[] PROGMEM = "no-cache";
+
+const WwwAsset WWW_ASSETS[] PROGMEM = {
+  { WWW_INDEX_CSS_PATH, WWW_INDEX_CSS_TYPE, WWW_INDEX_CSS, sizeof(WWW_INDEX_CSS), WWW_INDEX_CSS_ETAG, WWW_INDEX_CSS_CACHE },
+  { WWW_INDEX_JS_PATH, WWW_INDEX_JS_TYPE, WWW_INDEX_JS, sizeof(WWW_INDEX_JS), WWW_INDEX_JS_ETAG, WWW_INDEX_JS_CACHE },
+  { WWW_INDEX_HTML_PATH, WWW_INDEX_HTML_TYPE, WWW_INDEX_HTML, sizeof(WWW_INDEX_HTML), WWW_INDEX_HTML_ETAG, WWW_INDEX_HTML_CACHE },
+};
+
+const size_t WWW_NUM_ASSETS = sizeof(WWW_ASSETS) / sizeof(WwwAsset);
+
+#endif
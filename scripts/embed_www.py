@@ -0,0 +1,120 @@
+# Minify, gzip and embed the web portal in var/www as PROGMEM arrays in include/www.h,
+# so the portal is served straight from flash without a CDN.
+#
+# Runs before every PlatformIO build (see extra_scripts in platformio.ini), and can be
+# run by hand with `python scripts/embed_www.py`. The header is only rewritten when the
+# assets change.
+
+import gzip
+import hashlib
+import os
+import re
+
+try:
+    Import("env")  # noqa: F821, provided by PlatformIO
+    ROOT = env.subst("$PROJECT_DIR")  # noqa: F821
+except NameError:
+    ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+
+WWW = os.path.join(ROOT, "var", "www")
+HEADER = os.path.join(ROOT, "include", "www.h")
+
+# path, file, content type, cache control
+# the html is last, so it can reference the other assets by version and they can be cached forever
+ASSETS = [
+    ("/index.css", "index.css", "text/css", "public, max-age=31536000, immutable"),
+    ("/index.js", "index.js", "application/javascript", "public, max-age=31536000, immutable"),
+    ("/", "index.html", "text/html", "no-cache"),
+]
+
+
+def minify_css(text):
+    text = re.sub(r"/\*.*?\*/", "", text, flags=re.S)
+    text = re.sub(r"\s+", " ", text)
+    return re.sub(r"\s*([{};:,>])\s*", r"\1", text).strip()
+
+
+def minify_lines(text):
+    # conservative, safe for template literals: drop indentation, blank lines and whole-line comments
+    lines = (line.strip() for line in text.splitlines())
+    return "\n".join(line for line in lines if line and not line.startswith("//"))
+
+
+def minify(name, text):
+    if name.endswith(".css"):
+        return minify_css(text)
+    return minify_lines(text)
+
+
+def c_name(name):
+    return "WWW_" + re.sub(r"[^A-Za-z0-9]", "_", name).upper()
+
+
+def build():
+    out = [
+        "// generated by scripts/embed_www.py from var/www, do not edit",
+        "#include <Arduino.h>",
+        "",
+        "#ifndef WWW_h",
+        "#define WWW_h",
+        "",
+        "// everything is in flash, copy an entry out with memcpy_P() and read its strings with the _P functions",
+        "typedef struct {",
+        "  const char* path;",
+        "  const char* type;",
+        "  const uint8_t* data;",
+        "  size_t len;",
+        "  const char* etag;",
+        "  const char* cacheControl;",
+        "} WwwAsset;",
+        "",
+    ]
+    table = []
+    versions = {}
+
+    for path, name, content_type, cache_control in ASSETS:
+        with open(os.path.join(WWW, name), encoding="utf-8") as f:
+            text = minify(name, f.read())
+
+        for asset, version in versions.items():
+            text = text.replace('"%s"' % asset, '"%s?v=%s"' % (asset, version))
+
+        data = gzip.compress(text.encode("utf-8"), compresslevel=9, mtime=0)
+        version = hashlib.sha1(data).hexdigest()[:16]
+        versions[name] = version
+        var = c_name(name)
+        hex_bytes = ",".join("0x%02x" % b for b in data)
+        rows = [hex_bytes[i:i + 120] for i in range(0, len(hex_bytes), 120)]
+
+        out.append("// %s: %d bytes minified, %d bytes gzipped" % (name, len(text), len(data)))
+        out.append("const uint8_t %s[] PROGMEM = {" % var)
+        out.extend("  " + row for row in rows)
+        out.append("};")
+        out.append('const char %s_PATH[] PROGMEM = "%s";' % (var, path))
+        out.append('const char %s_TYPE[] PROGMEM = "%s";' % (var, content_type))
+        out.append('const char %s_ETAG[] PROGMEM = "\\"%s\\"";' % (var, version))
+        out.append('const char %s_CACHE[] PROGMEM = "%s";' % (var, cache_control))
+        out.append("")
+        table.append("  { %s_PATH, %s_TYPE, %s, sizeof(%s), %s_ETAG, %s_CACHE }," % ((var,) * 6))
+
+    out.append("const WwwAsset WWW_ASSETS[] PROGMEM = {")
+    out.extend(table)
+    out.append("};")
+    out.append("")
+    out.append("const size_t WWW_NUM_ASSETS = sizeof(WWW_ASSETS) / sizeof(WwwAsset);")
+    out.append("")
+    out.append("#endif")
+    out.append("")
+
+    header = "\n".join(out)
+    if os.path.exists(HEADER):
+        with open(HEADER, encoding="utf-8") as f:
+            if f.read() == header:
+                return
+
+    with open(HEADER, "w", encoding="utf-8") as f:
+        f.write(header)
+    print("Embedded web portal in include/www.h")
+
+
+build()
@@ -0,0 +1,145 @@
+# Record every effect at every speed and brightness tier as golden frame logs, and diff
+# a new build against them, so changes to the effects can't quietly change what they draw.
+#
+#   python scripts/golden.py esp8266.local --record
+#   python scripts/golden.py esp8266.local
+#   python scripts/golden.py esp8266.local --modes rainbow marquee --speeds 3
+#
+# Each combination is replayed through POST /trace/replay, which renders it from a fixed
+# seed on a fake clock (neoSetClock) and hashes every frame it shows (neoSetFrameHook),
+# so the same firmware always gives the same log. --record writes one small text file
+# per combination into --dir: a header line, then the time and hash of each frame. Commit
+# them, and run without --record after a change to see which combinations now draw
+# something different, and from which frame. Frames per second on the fake clock are
+# reported for every combination either way.
+#
+# Frames depend on the strip, so keep a directory per strip profile.
+
+import argparse
+import http.client
+import json
+import os
+import sys
+
+# audio follows the microphone, so it can't be replayed
+EFFECTS = ["solid", "breath", "marquee", "theater", "rainbow", "rainbow_marquee",
+           "rainbow_theater", "sparkle", "twinkle", "fire", "meteor"]
+
+SPEEDS = [1, 2, 3, 4, 5]
+
+# low, medium and high, as in /config/brightness/{tier}
+BRIGHTNESSES = [25, 75, 150]
+
+COLOR = [255, 120, 0]
+SEED = 1
+
+
+def request(host, method, path, body=None):
+    conn = http.client.HTTPConnection(host, timeout=60)
+
+    try:
+        conn.request(method, path, body=json.dumps(body) if body is not None else None)
+        return json.loads(conn.getresponse().read())
+    finally:
+        conn.close()
+
+
+def replay(host, mode, speed, brightness, ms, step):
+    result = request(host, "POST", "/trace/replay", {
+        "mode": mode, "speed": speed, "brightness": brightness, "color": COLOR,
+        "seed": SEED, "ms": ms, "step": step})
+
+    if "error" in result:
+        raise RuntimeError("%s: %s" % (mode, result["error"]))
+
+    return result
+
+
+def file_name(mode, speed, brightness):
+    return "%s-s%d-b%d.txt" % (mode, speed, brightness)
+
+
+def header(strip, run):
+    return "pixels %d bpp %d ms %d step %d frames %d steps %d final %s" % (
+        strip["pixels"], strip["bytes_per_pixel"], run["ms"], run["step"], run["frames"], run["steps"], run["final"])
+
+
+def write_log(path, strip, run):
+    with open(path, "w") as f:
+        f.write(header(strip, run) + "\n")
+
+        for at, frame in run["log"]:
+            f.write("%d %s\n" % (at, frame))
+
+
+def read_log(path):
+    with open(path) as f:
+        lines = f.read().splitlines()
+
+    return lines[0], [tuple(line.split()) for line in lines[1:]]
+
+
+# the first difference, or None when they match
+def diff(path, strip, run):
+    if not os.path.exists(path):
+        return "no golden file, run with --record"
+
+    golden_header, golden_log = read_log(path)
+    log = [(str(at), frame) for at, frame in run["log"]]
+
+    for i, (expected, actual) in enumerate(zip(golden_log, log)):
+        if expected != actual:
+            return "frame %d differs: expected %s at %sms, got %s at %sms" % (
+                i, expected[1], expected[0], actual[1], actual[0])
+
+    if len(golden_log) != len(log):
+        return "expected %d logged frames, got %d" % (len(golden_log), len(log))
+
+    if golden_header != header(strip, run):
+        return "expected '%s', got '%s'" % (golden_header, header(strip, run))
+
+    return None
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Record or check golden frame logs for every effect.")
+    parser.add_argument("host", help="hostname or ip, optionally with :port")
+    parser.add_argument("--record", action="store_true", help="write new golden files instead of checking")
+    parser.add_argument("--dir", default="golden", help="where the golden files live")
+    parser.add_argument("--ms", type=int, default=2500, help="how long to replay each combination for, 256 frames are logged")
+    parser.add_argument("--step", type=int, default=10, help="ms the fake clock moves per loop")
+    parser.add_argument("--modes", nargs="+", default=EFFECTS)
+    parser.add_argument("--speeds", type=int, nargs="+", default=SPEEDS)
+    parser.add_argument("--brightness", type=int, nargs="+", default=BRIGHTNESSES)
+    args = parser.parse_args()
+
+    # the hashes cover the whole strip buffer, so they're only comparable on the same strip
+    strip = request(args.host, "GET", "/frame")
+    os.makedirs(args.dir, exist_ok=True)
+    failures = 0
+
+    for mode in args.modes:
+        for speed in args.speeds:
+            for brightness in args.brightness:
+                run = replay(args.host, mode, speed, brightness, args.ms, args.step)
+                path = os.path.join(args.dir, file_name(mode, speed, brightness))
+                fps = run["frames"] * 1000.0 / run["ms"] if run["ms"] else 0
+
+                if args.record:
+                    write_log(path, strip, run)
+                    result = "recorded"
+                else:
+                    problem = diff(path, strip, run)
+                    failures += problem is not None
+                    result = "FAIL " + problem if problem else "ok"
+
+                print("%-16s speed %d  brightness %3d  %6.1f fps  %s" % (mode, speed, brightness, fps, result))
+
+    if failures:
+        print("[ERROR] %d combinations no longer match their golden files" % failures)
+
+    sys.exit(1 if failures else 0)
+
+
+if __name__ == "__main__":
+    main()
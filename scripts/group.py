@@ -0,0 +1,215 @@
+# Send a command to a group of lights with one multicast packet, or simulate a
+# room full of lights on this machine to measure fan-out.
+#
+#   python scripts/group.py status dnd --group 3
+#   python scripts/group.py color ff0000 --alpha 100
+#   python scripts/group.py mode 4
+#   python scripts/group.py config '{"status": "In a meeting", "color": [255, 0, 255]}'
+#   python scripts/group.py simulate --nodes 40 --packets 200
+#
+# Packets are 'S' 'L' version group seq[4] command args, see include/group.h. Every
+# packet is sent --repeat times with the same sequence number, lights apply the first
+# copy that arrives and drop the rest. Group 0 reaches every light on the network.
+
+import argparse
+import json
+import socket
+import struct
+import threading
+import time
+
+ADDRESS = "239.76.73.71"
+PORT = 4210
+VERSION = 1
+
+GROUP_STATUS, GROUP_COLOR, GROUP_MODE, GROUP_CONFIG, GROUP_PRESET = 1, 2, 3, 4, 5
+
+# same order as STATUSES in include/defaults.h
+STATUSES = ["free", "busy", "dnd", "unknown", "party"]
+
+
+def next_seq():
+    # milliseconds keep counting up across runs, so a new run is never taken for a repeat
+    return int(time.time() * 1000) & 0xFFFFFFFF
+
+
+def make_packet(group, seq, command, args):
+    return b"SL" + struct.pack(">BBIB", VERSION, group, seq, command) + args
+
+
+def parse_packet(packet):
+    if len(packet) < 9 or packet[:2] != b"SL" or packet[2] != VERSION:
+        return None
+
+    _, group, seq, command = struct.unpack(">BBIB", packet[2:9])
+    return group, seq, command, packet[9:]
+
+
+def is_newer(seq, last):
+    # same wrap-around comparison as takeSequence() in src/group.cpp
+    return last is None or 0 < ((seq - last) & 0xFFFFFFFF) < 0x80000000
+
+
+def command_args(args):
+    if args.command == "status":
+        return GROUP_STATUS, bytes([STATUSES.index(args.value.lower())])
+
+    if args.command == "color":
+        rgb = bytes.fromhex(args.value.lstrip("#"))
+        return GROUP_COLOR, rgb + (bytes([args.alpha]) if args.alpha is not None else b"")
+
+    if args.command == "mode":
+        return GROUP_MODE, bytes([int(args.value)])
+
+    if args.command == "preset":
+        return GROUP_PRESET, bytes([int(args.value)])
+
+    json.loads(args.value)  # fail here rather than on every light
+    return GROUP_CONFIG, args.value.encode()
+
+
+def sender_socket(interface=None):
+    sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM, socket.IPPROTO_UDP)
+    sock.setsockopt(socket.IPPROTO_IP, socket.IP_MULTICAST_TTL, 1)
+
+    if interface:
+        sock.setsockopt(socket.IPPROTO_IP, socket.IP_MULTICAST_IF, socket.inet_aton(interface))
+        sock.setsockopt(socket.IPPROTO_IP, socket.IP_MULTICAST_LOOP, 1)
+
+    return sock
+
+
+def send(args):
+    command, payload = command_args(args)
+    packet = make_packet(args.group, next_seq(), command, payload)
+    sock = sender_socket()
+
+    for i in range(args.repeat):
+        sock.sendto(packet, (args.address, args.port))
+        time.sleep(args.gap / 1000.0)
+
+    print("sent %d bytes to group %d, %d times" % (len(packet), args.group, args.repeat))
+
+
+class Node(threading.Thread):
+    # a light as far as the network is concerned: joins the group, drops repeats, records arrivals
+
+    def __init__(self, address, port, groups):
+        super().__init__(daemon=True)
+        self.groups = groups
+        self.last_seq = {}
+        self.arrivals = {}
+        self.duplicates = 0
+        self.sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM, socket.IPPROTO_UDP)
+        self.sock.setsockopt(socket.SOL_SOCKET, socket.SO_REUSEADDR, 1)
+
+        if hasattr(socket, "SO_REUSEPORT"):
+            self.sock.setsockopt(socket.SOL_SOCKET, socket.SO_REUSEPORT, 1)
+
+        self.sock.bind(("", port))
+        membership = socket.inet_aton(address) + socket.inet_aton("127.0.0.1")
+        self.sock.setsockopt(socket.IPPROTO_IP, socket.IP_ADD_MEMBERSHIP, membership)
+        self.sock.settimeout(0.2)
+        self.running = True
+
+    def run(self):
+        while self.running:
+            try:
+                packet, sender = self.sock.recvfrom(512)
+            except socket.timeout:
+                continue
+
+            now = time.perf_counter()
+            parsed = parse_packet(packet)
+
+            if not parsed:
+                continue
+
+            group, seq, _, _ = parsed
+
+            if group and group not in self.groups:
+                continue
+
+            if not is_newer(seq, self.last_seq.get(sender[0])):
+                self.duplicates += 1
+                continue
+
+            self.last_seq[sender[0]] = seq
+            self.arrivals[seq] = now
+
+
+def percentile(values, p):
+    if not values:
+        return 0.0
+
+    values = sorted(values)
+    return values[min(len(values) - 1, int(round(p / 100.0 * (len(values) - 1))))]
+
+
+def simulate(args):
+    nodes = [Node(args.address, args.port, {1}) for _ in range(args.nodes)]
+
+    for node in nodes:
+        node.start()
+
+    sock = sender_socket("127.0.0.1")
+    sent = {}
+    seq = next_seq()
+
+    for i in range(args.packets):
+        seq = (seq + 1) & 0xFFFFFFFF
+        packet = make_packet(1, seq, GROUP_STATUS, bytes([i % len(STATUSES)]))
+        sent[seq] = time.perf_counter()
+
+        for _ in range(args.repeat):
+            sock.sendto(packet, (args.address, args.port))
+
+        time.sleep(args.gap / 1000.0)
+
+    time.sleep(0.5)
+
+    for node in nodes:
+        node.running = False
+
+    fanout = []
+    delivered = 0
+
+    for seq, start in sent.items():
+        arrivals = [node.arrivals[seq] for node in nodes if seq in node.arrivals]
+        delivered += len(arrivals)
+
+        if len(arrivals) == len(nodes):
+            fanout.append((max(arrivals) - start) * 1000)
+
+    expected = len(sent) * len(nodes)
+    print("nodes      %d, packets %d, each sent %d times" % (len(nodes), len(sent), args.repeat))
+    print("delivered  %d of %d (%.1f%%), %d repeats dropped" % (
+        delivered, expected, 100.0 * delivered / expected, sum(node.duplicates for node in nodes)))
+    print("fan-out ms p50 %.2f, p95 %.2f, p99 %.2f, max %.2f (until the last node has it)" % (
+        percentile(fanout, 50), percentile(fanout, 95), percentile(fanout, 99), max(fanout or [0])))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Control groups of status lights over UDP multicast.")
+    parser.add_argument("command", choices=["status", "color", "mode", "config", "preset", "simulate"])
+    parser.add_argument("value", nargs="?", help="status name, hex color, mode number, POST /config body, or preset id")
+    parser.add_argument("--group", type=int, default=0, help="1 to 32, or 0 for every light")
+    parser.add_argument("--alpha", type=int, help="brightness to send along with a color")
+    parser.add_argument("--address", default=ADDRESS)
+    parser.add_argument("--port", type=int, default=PORT)
+    parser.add_argument("--repeat", type=int, default=3, help="copies of each packet, repeats are dropped")
+    parser.add_argument("--gap", type=float, default=5, help="ms between copies or packets")
+    parser.add_argument("--nodes", type=int, default=40, help="simulated lights")
+    parser.add_argument("--packets", type=int, default=100, help="commands to send when simulating")
+    args = parser.parse_args()
+
+    if args.command == "simulate":
+        simulate(args)
+    elif args.value is None:
+        parser.error("%s needs a value" % args.command)
+    else:
+        send(args)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,165 @@
+# Load test one or more lights over the REST api and report throughput, latency
+# percentiles, and how the render loop held up while under load.
+#
+#   python scripts/loadtest.py esp8266.local
+#   python scripts/loadtest.py 192.168.1.20 192.168.1.21 --requests 500 --concurrency 8
+#
+# Every host is hit at the same time, each by its own pool of workers. Render rate and
+# deadline misses come from the scheduler counters in GET /metrics, sampled before and
+# after the run. Expect 429s past 10 requests per second from one machine, that's the
+# per-client rate limit doing its job, and 503s past 8 requests in flight.
+
+import argparse
+import http.client
+import json
+import threading
+import time
+from concurrent.futures import ThreadPoolExecutor
+
+# method, path, body
+DEFAULT_MIX = [
+    ("GET", "/config/state", None),
+    ("GET", "/config/mode/next", None),
+    ("POST", "/config", {"brightness": 75}),
+    ("GET", "/config/color/ff8000", None),
+]
+
+
+def request(host, method, path, body=None, timeout=5):
+    conn = http.client.HTTPConnection(host, timeout=timeout)
+    payload = json.dumps(body) if body is not None else None
+    start = time.perf_counter()
+
+    try:
+        conn.request(method, path, body=payload)
+        response = conn.getresponse()
+        data = response.read()
+        return response.status, time.perf_counter() - start, data
+    finally:
+        conn.close()
+
+
+def get_metrics(host):
+    # right after a run the rate limit has nothing left, so wait for it to refill
+    for _ in range(20):
+        try:
+            status, _, data = request(host, "GET", "/metrics")
+        except OSError:
+            return None
+
+        if status != 429:
+            break
+
+        time.sleep(0.1)
+
+    try:
+        return json.loads(data) if status == 200 else None
+    except ValueError:
+        return None
+
+
+def task_counters(metrics, name):
+    for task in (metrics or {}).get("tasks", []):
+        if task["name"] == name:
+            return task
+
+    return None
+
+
+def percentile(values, p):
+    if not values:
+        return 0.0
+
+    values = sorted(values)
+    return values[min(len(values) - 1, int(round(p / 100.0 * (len(values) - 1))))]
+
+
+def run_host(host, total, concurrency, mix):
+    latencies = []
+    codes = {}
+    errors = 0
+    lock = threading.Lock()
+
+    def worker(i):
+        nonlocal errors
+        method, path, body = mix[i % len(mix)]
+
+        try:
+            status, took, _ = request(host, method, path, body)
+        except OSError:
+            with lock:
+                errors += 1
+            return
+
+        with lock:
+            codes[status] = codes.get(status, 0) + 1
+            if status == 200:
+                latencies.append(took * 1000)
+
+    before = get_metrics(host)
+    sampled = time.perf_counter()
+    start = time.perf_counter()
+
+    with ThreadPoolExecutor(max_workers=concurrency) as pool:
+        list(pool.map(worker, range(total)))
+
+    elapsed = time.perf_counter() - start
+    after = get_metrics(host)
+    window = time.perf_counter() - sampled  # render counters cover the time between samples
+
+    return {
+        "host": host,
+        "elapsed": elapsed,
+        "window": window,
+        "codes": codes,
+        "errors": errors,
+        "latencies": latencies,
+        "render_before": task_counters(before, "render"),
+        "render_after": task_counters(after, "render"),
+        "frames": (after or {}).get("frames", 0) - (before or {}).get("frames", 0),
+    }
+
+
+def report(result):
+    codes = result["codes"]
+    done = sum(codes.values())
+    latencies = result["latencies"]
+    elapsed = result["elapsed"]
+
+    print("== %s" % result["host"])
+    print("  requests   %d in %.2fs, %.1f req/s" % (done, elapsed, done / elapsed if elapsed else 0))
+    print("  responses  " + ", ".join("%s: %d" % (code, n) for code, n in sorted(codes.items())) + ", errors: %d" % result["errors"])
+    print("  latency ms p50 %.1f, p95 %.1f, p99 %.1f, max %.1f" % (
+        percentile(latencies, 50), percentile(latencies, 95), percentile(latencies, 99), max(latencies or [0])))
+
+    before, after = result["render_before"], result["render_after"]
+
+    if before and after:
+        passes = after["runs"] - before["runs"]
+        window = result["window"]
+        print("  render     %.1f frames/s, %.1f passes/s, %d deadline misses, worst pass %dus" % (
+            result["frames"] / window if window else 0, passes / window if window else 0,
+            after["misses"] - before["misses"], after["max_us"]))
+    else:
+        print("  render     no /metrics available")
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Load test status lights over the REST api.")
+    parser.add_argument("hosts", nargs="+", help="hostnames or ips, optionally with :port")
+    parser.add_argument("--requests", type=int, default=200, help="requests per host")
+    parser.add_argument("--concurrency", type=int, default=4, help="requests in flight per host")
+    parser.add_argument("--path", action="append", help="only GET this path, can be repeated")
+    args = parser.parse_args()
+
+    mix = [("GET", path, None) for path in args.path] if args.path else DEFAULT_MIX
+
+    with ThreadPoolExecutor(max_workers=len(args.hosts)) as pool:
+        results = list(pool.map(lambda host: run_host(host, args.requests, args.concurrency, mix), args.hosts))
+
+    for result in results:
+        report(result)
+
+
+if __name__ == "__main__":
+    main()
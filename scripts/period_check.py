@@ -0,0 +1,100 @@
+# Check that every effect's cycle period depends only on its rate, never on how often
+# the loop gets to it.
+#
+#   python scripts/period_check.py esp8266.local
+#   python scripts/period_check.py esp8266.local --ms 3000 --steps 1 7 50 400
+#
+# Each effect is replayed through POST /trace/replay, which renders it on a fake clock
+# (neoSetClock) that moves a fixed step per neoLoop(). A slow loop only shows fewer of
+# the frames, so every step size must advance the effect the same number of steps and
+# land on the same final frame. The effect must also step twice as often at twice the
+# rate. Exits non-zero on any mismatch.
+#
+# A step size so long that the device can't keep up drops steps on purpose (see
+# NEO_MAX_OWED_STEPS in include/light.h). Those runs are reported but not compared.
+
+import argparse
+import http.client
+import json
+import sys
+
+# audio follows the microphone, so it can't be replayed
+EFFECTS = ["solid", "breath", "marquee", "theater", "rainbow", "rainbow_marquee",
+           "rainbow_theater", "sparkle", "twinkle", "fire", "meteor"]
+
+
+def replay(host, mode, rate, ms, step, seed=1):
+    conn = http.client.HTTPConnection(host, timeout=60)
+    body = {"mode": mode, "rate": rate, "ms": ms, "step": step, "seed": seed,
+            "color": [255, 120, 0], "brightness": 150}
+
+    try:
+        conn.request("POST", "/trace/replay", body=json.dumps(body))
+        result = json.loads(conn.getresponse().read())
+    finally:
+        conn.close()
+
+    if "error" in result:
+        raise RuntimeError("%s: %s" % (mode, result["error"]))
+
+    return result
+
+
+def check(host, mode, rates, ms, steps):
+    problems = []
+    counts = {}
+
+    for rate in rates:
+        runs = [replay(host, mode, rate, ms, step) for step in steps]
+        first = runs[0]
+        counts[rate] = first["steps"]
+        matched = True
+
+        for step, run in zip(steps[1:], runs[1:]):
+            if run.get("dropped"):
+                print("%-16s %4gx  %dms steps dropped %d steps, too slow to keep up" % (mode, rate, step, run["dropped"]))
+                continue
+
+            if run["steps"] != first["steps"] or run["final"] != first["final"]:
+                matched = False
+                problems.append("%s at %gx: %dms steps gave %d steps ending on %s, %dms steps gave %d ending on %s" % (
+                    mode, rate, steps[0], first["steps"], first["final"], step, run["steps"], run["final"]))
+
+        period = ms / float(first["steps"] - 1) if first["steps"] > 1 else 0
+        print("%-16s %4gx  %5d steps  %7.2fms per step  %s" % (mode, rate, first["steps"], period,
+                                                             "ok" if matched else "MISMATCH"))
+
+    # the first step is drawn at once, the rest are paid for by the clock
+    for slow, fast in zip(rates, rates[1:]):
+        expected = (counts[slow] - 1) * fast / slow
+
+        if counts[slow] > 1 and abs((counts[fast] - 1) - expected) > fast / slow:
+            problems.append("%s: %d steps at %gx but %d at %gx, expected about %d" % (
+                mode, counts[slow] - 1, slow, counts[fast] - 1, fast, expected))
+
+    return problems
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Check effect cycle periods against a fake clock.")
+    parser.add_argument("host", help="hostname or ip, optionally with :port")
+    parser.add_argument("--ms", type=int, default=5000, help="how long to replay each effect for")
+    parser.add_argument("--steps", type=int, nargs="+", default=[1, 16, 50, 250],
+                        help="ms the clock moves per loop, the first is the reference")
+    parser.add_argument("--rates", type=float, nargs="+", default=[0.5, 1, 2], help="rates to check, in order")
+    parser.add_argument("--modes", nargs="+", default=EFFECTS)
+    args = parser.parse_args()
+
+    problems = []
+
+    for mode in args.modes:
+        problems += check(args.host, mode, args.rates, args.ms, args.steps)
+
+    for problem in problems:
+        print("[ERROR] " + problem)
+
+    sys.exit(1 if problems else 0)
+
+
+if __name__ == "__main__":
+    main()
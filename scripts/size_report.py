@@ -0,0 +1,260 @@
+# Report where RAM and flash go, symbol by symbol, and fail the build when either is
+# over budget.
+#
+#   pio run -e d1_mini_lite -t size_report
+#   python scripts/size_report.py .pio/build/d1_mini_lite/firmware.elf --top 40
+#
+# Every build checks the budgets and prints a one line summary (see extra_scripts in
+# platformio.ini). The size_report target, or running this by hand, also lists the
+# biggest symbols in each region. Totals and symbol sizes are saved next to the ELF
+# as size.json, and the next report shows what changed since, so RAM freed by a
+# change shows up before it's flashed. Budgets are set per environment with
+# custom_ram_budget and custom_flash_budget, in bytes.
+
+import argparse
+import glob
+import json
+import os
+import shutil
+import subprocess
+import sys
+
+# static RAM: .data, .rodata and .bss all live in the 80KB of DRAM, whatever is left is heap
+RAM_BUDGET = 40960
+
+# the sketch must fit twice for OTA, so under half of the ~940KB sketch space on a 1MB board
+FLASH_BUDGET = 450 * 1024
+
+IRAM_SIZE = 32768
+
+TOOL_PREFIX = "xtensa-lx106-elf-"
+
+# address ranges on the ESP8266
+REGIONS = [
+    ("dram", 0x3FFE8000, 0x40000000),
+    ("iram", 0x40100000, 0x40110000),
+    ("flash", 0x40200000, 0x40300000),
+]
+
+
+def region_of(address):
+    for name, start, end in REGIONS:
+        if start <= address < end:
+            return name
+
+    return None
+
+
+def find_tool(prefix, tool):
+    # on the PATH inside a PlatformIO build, otherwise in its toolchain package
+    name = prefix + tool
+
+    if shutil.which(name):
+        return name
+
+    candidates = glob.glob(os.path.expanduser("~/.platformio/packages/toolchain-xtensa*/bin/" + name))
+
+    return candidates[0] if candidates else name
+
+
+def run(command):
+    return subprocess.run(command, check=True, capture_output=True, text=True).stdout
+
+
+def read_sections(size_tool, elf):
+    sections = {}
+
+    for line in run([size_tool, "-A", "-d", elf]).splitlines():
+        parts = line.split()
+
+        if len(parts) == 3 and parts[0].startswith(".") and parts[1].isdigit():
+            sections[parts[0]] = (int(parts[1]), int(parts[2]))
+
+    return sections
+
+
+def read_symbols(nm_tool, elf):
+    symbols = []
+
+    for line in run([nm_tool, "-S", "-C", "--size-sort", elf]).splitlines():
+        parts = line.split(None, 3)
+
+        if len(parts) < 4:
+            continue
+
+        address, size, kind, name = int(parts[0], 16), int(parts[1], 16), parts[2], parts[3]
+        region = region_of(address)
+
+        if region:
+            symbols.append({"name": name, "size": size, "kind": kind, "region": region})
+
+    return symbols
+
+
+def totals_of(sections):
+    totals = {"ram": 0, "iram": 0, "flash": 0}
+
+    for name, (size, address) in sections.items():
+        region = region_of(address)
+
+        if region == "dram":
+            totals["ram"] += size
+        elif region == "iram":
+            totals["iram"] += size
+
+        # everything but .bss and .noinit is stored in the flash image
+        if region and name not in (".bss", ".noinit"):
+            totals["flash"] += size
+
+    return totals
+
+
+def measure(elf, prefix=TOOL_PREFIX):
+    sections = read_sections(find_tool(prefix, "size"), elf)
+    symbols = read_symbols(find_tool(prefix, "nm"), elf)
+    totals = totals_of(sections)
+
+    # string literals and padding have no symbol of their own
+    named = sum(s["size"] for s in symbols if s["region"] == "dram")
+    totals["ram_unnamed"] = max(0, totals["ram"] - named)
+
+    return {"totals": totals, "symbols": symbols}
+
+
+def percent(used, budget):
+    return 100.0 * used / budget if budget else 0
+
+
+def summary(usage, ram_budget, flash_budget):
+    totals = usage["totals"]
+
+    return "RAM %d of %d (%.0f%%), flash %d of %d (%.0f%%), IRAM %d of %d" % (
+        totals["ram"], ram_budget, percent(totals["ram"], ram_budget),
+        totals["flash"], flash_budget, percent(totals["flash"], flash_budget),
+        totals["iram"], IRAM_SIZE)
+
+
+def over_budget(usage, ram_budget, flash_budget):
+    totals = usage["totals"]
+    problems = []
+
+    if totals["ram"] > ram_budget:
+        problems.append("static RAM is %d bytes over its budget" % (totals["ram"] - ram_budget))
+
+    if totals["flash"] > flash_budget:
+        problems.append("the sketch is %d bytes over its flash budget, OTA may fail" % (totals["flash"] - flash_budget))
+
+    if totals["iram"] > IRAM_SIZE:
+        problems.append("IRAM is %d bytes over" % (totals["iram"] - IRAM_SIZE))
+
+    return problems
+
+
+def load_baseline(path):
+    try:
+        with open(path) as f:
+            return json.load(f)
+    except (OSError, ValueError):
+        return None
+
+
+def save_baseline(path, usage):
+    with open(path, "w") as f:
+        json.dump(usage, f)
+
+
+def report(usage, ram_budget, flash_budget, top, baseline=None):
+    totals = usage["totals"]
+    print(summary(usage, ram_budget, flash_budget))
+    print("  %d bytes of RAM are string literals and padding with no symbol" % totals["ram_unnamed"])
+
+    if baseline:
+        before = baseline["totals"]
+        print("  since the last report: RAM %+d, flash %+d, IRAM %+d" % (
+            totals["ram"] - before["ram"], totals["flash"] - before["flash"], totals["iram"] - before["iram"]))
+
+    for region, title in (("dram", "RAM"), ("flash", "flash"), ("iram", "IRAM")):
+        symbols = sorted((s for s in usage["symbols"] if s["region"] == region), key=lambda s: -s["size"])
+        print()
+        print("biggest in %s:" % title)
+
+        for symbol in symbols[:top]:
+            print("  %7d  %s %s" % (symbol["size"], symbol["kind"], symbol["name"]))
+
+    if baseline:
+        old = {(s["region"], s["name"]): s["size"] for s in baseline["symbols"]}
+        new = {(s["region"], s["name"]): s["size"] for s in usage["symbols"]}
+        changes = [(new.get(key, 0) - old.get(key, 0), key) for key in set(old) | set(new)]
+        changes = sorted((c for c in changes if c[0]), key=lambda c: -abs(c[0]))
+
+        if changes:
+            print()
+            print("changed since the last report:")
+
+            for delta, (region, name) in changes[:top]:
+                print("  %+7d  %-5s %s" % (delta, region, name))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Per symbol RAM and flash usage with a budget check.")
+    parser.add_argument("elf", help="e.g. .pio/build/d1_mini_lite/firmware.elf")
+    parser.add_argument("--top", type=int, default=25, help="symbols listed per region")
+    parser.add_argument("--ram-budget", type=int, default=RAM_BUDGET)
+    parser.add_argument("--flash-budget", type=int, default=FLASH_BUDGET)
+    parser.add_argument("--prefix", default=TOOL_PREFIX, help="toolchain prefix for nm and size")
+    args = parser.parse_args()
+
+    usage = measure(args.elf, args.prefix)
+    baseline_path = os.path.join(os.path.dirname(args.elf), "size.json")
+    report(usage, args.ram_budget, args.flash_budget, args.top, load_baseline(baseline_path))
+    save_baseline(baseline_path, usage)
+
+    problems = over_budget(usage, args.ram_budget, args.flash_budget)
+
+    for problem in problems:
+        print("[ERROR] " + problem)
+
+    sys.exit(1 if problems else 0)
+
+
+try:
+    Import("env")  # noqa: F821, provided by PlatformIO
+except NameError:
+    env = None
+
+if env is not None:
+    ELF = "$BUILD_DIR/${PROGNAME}.elf"
+
+    def budgets(env):
+        return (int(env.GetProjectOption("custom_ram_budget", RAM_BUDGET)),
+                int(env.GetProjectOption("custom_flash_budget", FLASH_BUDGET)))
+
+    def check(source, target, env):
+        ram_budget, flash_budget = budgets(env)
+        usage = measure(env.subst(ELF))
+        print(summary(usage, ram_budget, flash_budget))
+        problems = over_budget(usage, ram_budget, flash_budget)
+
+        for problem in problems:
+            print("[ERROR] " + problem)
+
+        return 1 if problems else 0
+
+    def size_report(source, target, env):
+        ram_budget, flash_budget = budgets(env)
+        elf = env.subst(ELF)
+        usage = measure(elf)
+        baseline_path = os.path.join(os.path.dirname(elf), "size.json")
+        report(usage, ram_budget, flash_budget, 25, load_baseline(baseline_path))
+        save_baseline(baseline_path, usage)
+
+    env.AddPostAction(ELF, check)
+    env.AddCustomTarget(
+        name="size_report",
+        dependencies=ELF,
+        actions=size_report,
+        title="Size Report",
+        description="Per symbol RAM and flash usage against the budgets",
+    )
+elif __name__ == "__main__":
+    main()
@@ -0,0 +1,106 @@
+# Record what a light is rendering and summarize it, for chasing down flicker remotely.
+#
+#   python scripts/trace.py esp8266.local --seconds 5
+#   python scripts/trace.py esp8266.local --seconds 5 --save trace.json
+#   python scripts/trace.py --load trace.json
+#
+# Starts the flight recorder, waits, stops it, and prints the state changes and frame
+# timings it caught. The recorder only keeps the last 64 records, so keep recordings
+# short on fast animations. A saved trace has the rng seed and every state change with
+# its time on the renderer's clock, which is everything needed to render the same
+# frames again through neoSetClock().
+
+import argparse
+import http.client
+import json
+import time
+
+
+def request(host, method, path, body=None):
+    conn = http.client.HTTPConnection(host, timeout=5)
+
+    try:
+        conn.request(method, path, body=json.dumps(body) if body is not None else None)
+        response = conn.getresponse()
+        return json.loads(response.read())
+    finally:
+        conn.close()
+
+
+def record(host, seconds):
+    request(host, "POST", "/trace", {"recording": True})
+    time.sleep(seconds)
+    trace = request(host, "POST", "/trace", {"recording": False})
+    trace["frame"] = request(host, "GET", "/frame")
+
+    return trace
+
+
+def percentile(values, p):
+    if not values:
+        return 0
+
+    values = sorted(values)
+    return values[min(len(values) - 1, int(round(p / 100.0 * (len(values) - 1))))]
+
+
+def report(trace):
+    records = trace["records"]
+    frames = [r for r in records if r[0] == "frame"]
+    start = records[0][1] if records else 0
+
+    print("seed %d, %d frames recorded, last %d records kept" % (trace["seed"], trace["frames"], len(records)))
+    print("recorder overhead: max %dus, avg %dus, %d frames over the %dus budget" % (
+        trace["overhead_max_us"], trace["overhead_avg_us"], trace["over_budget"], trace["budget_us"]))
+
+    if frames:
+        shows = [r[3] for r in frames]
+        gaps = [r[4] / 1000.0 for r in frames if r[4]]
+        print("show() us: p50 %d, p99 %d, max %d" % (percentile(shows, 50), percentile(shows, 99), max(shows)))
+
+        if gaps:
+            print("frame gap ms: p50 %.1f, p99 %.1f, max %.1f" % (percentile(gaps, 50), percentile(gaps, 99), max(gaps)))
+
+        print("estimated draw: max %dmA" % max(r[5] for r in frames))
+
+    print()
+
+    for r in records:
+        if r[0] != "frame":
+            value = "#%06x" % r[3] if r[0] == "color" else r[3]
+            print("%8dms  %-10s %s" % (r[1] - start, r[0], value))
+
+    frame = trace.get("frame")
+
+    if frame:
+        print()
+        print("last frame: %d pixels, dimmed to %d/256 by the current limit" % (frame["pixels"], frame["limit_scale"]))
+        size = frame["bytes_per_pixel"] * 2
+        print(" ".join(frame["frame"][i:i + size] for i in range(0, len(frame["frame"]), size)))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Record and summarize a light's flight recorder.")
+    parser.add_argument("host", nargs="?", help="hostname or ip, optionally with :port")
+    parser.add_argument("--seconds", type=float, default=5, help="how long to record for")
+    parser.add_argument("--save", help="write the raw trace to this file")
+    parser.add_argument("--load", help="summarize a saved trace instead of recording")
+    args = parser.parse_args()
+
+    if args.load:
+        with open(args.load) as f:
+            trace = json.load(f)
+    elif args.host:
+        trace = record(args.host, args.seconds)
+    else:
+        parser.error("a host or --load is required")
+
+    if args.save:
+        with open(args.save, "w") as f:
+            json.dump(trace, f)
+
+    report(trace)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,139 @@
+#include <Arduino.h>
+#include "audio.h"
+
+// band centers in Hz, roughly log spaced below nyquist
+const uint16_t AUDIO_BAND_HZ[AUDIO_NUM_BANDS] = { 62, 94, 156, 250, 375, 500, 687, 937 };
+const uint8_t AUDIO_FLOOR = 14; // log2 power below this is treated as silence
+const uint8_t AUDIO_RANGE = 18; // log2 power above the floor that maps to full brightness
+const uint16_t AUDIO_EVEN_SAMPLES = (uint32_t)AUDIO_SAMPLE_RATE * AUDIO_WINDOW_US / 1000000; // a window sampled on time
+
+uint16_t readAnalogSample() {
+  return analogRead(A0);
+}
+
+AudioSampleReader audio_reader = readAnalogSample;
+unsigned long audio_period_us = 1000000UL / AUDIO_SAMPLE_RATE;
+unsigned long last_sample_micros = 0;
+int32_t audio_dc = 512L << 8; // running mean in Q8, the ADC idles at mid scale
+
+// the loop can't promise evenly spaced samples, so instead of a filter that
+// assumes them, each sample is correlated with every band at the time it was
+// actually taken. a late loop only means fewer samples in the window
+int16_t audio_sine[AUDIO_SINE_SIZE]; // one cycle, Q14
+uint32_t band_step[AUDIO_NUM_BANDS]; // how far each band turns per us, 2^32 is a full cycle
+int32_t band_re[AUDIO_NUM_BANDS];
+int32_t band_im[AUDIO_NUM_BANDS];
+unsigned long window_start = 0;
+uint16_t window_samples = 0;
+uint32_t audio_windows = 0;
+uint32_t audio_skipped = 0;
+
+uint8_t band_level[AUDIO_NUM_BANDS];
+
+void audioSetup() {
+  // the only floating point, done once
+  for (uint8_t i = 0; i < AUDIO_SINE_SIZE; i++) {
+    audio_sine[i] = sin(2.0 * PI * i / AUDIO_SINE_SIZE) * 16384;
+  }
+
+  for (uint8_t i = 0; i < AUDIO_NUM_BANDS; i++) {
+    band_step[i] = AUDIO_BAND_HZ[i] * 4294.967296; // 2^32 / 1000000
+  }
+}
+
+void audioSetSource(AudioSampleReader reader) {
+  audio_reader = reader ? reader : readAnalogSample;
+}
+
+uint8_t powerToLevel(uint64_t power) {
+  uint8_t log2Power = 0;
+
+  while (power >>= 1) {
+    log2Power++;
+  }
+
+  if (log2Power <= AUDIO_FLOOR) {
+    return 0;
+  }
+
+  return min((log2Power - AUDIO_FLOOR) * 255 / AUDIO_RANGE, 255);
+}
+
+// turn the window's correlations into band levels, scaled as if it had been sampled on time
+void closeWindow() {
+  bool enough = window_samples >= AUDIO_MIN_SAMPLES;
+
+  for (uint8_t band = 0; band < AUDIO_NUM_BANDS; band++) {
+    uint8_t level = 0;
+
+    if (enough) {
+      int64_t re = ((int64_t)band_re[band] * AUDIO_EVEN_SAMPLES / window_samples) >> 8;
+      int64_t im = ((int64_t)band_im[band] * AUDIO_EVEN_SAMPLES / window_samples) >> 8;
+      level = powerToLevel(re * re + im * im);
+    }
+
+    // jump up to peaks, fall back down slowly
+    band_level[band] = level > band_level[band] ? level : band_level[band] - (band_level[band] >> 2);
+    band_re[band] = 0;
+    band_im[band] = 0;
+  }
+
+  if (enough) {
+    audio_windows++;
+  } else {
+    audio_skipped++;
+  }
+
+  window_samples = 0;
+}
+
+// a sample of the 10 bit ADC, taken at atUs
+void audioPushSample(uint16_t raw, unsigned long atUs) {
+  if (window_samples && atUs - window_start >= AUDIO_WINDOW_US) {
+    closeWindow();
+  }
+
+  if (!window_samples) {
+    window_start = atUs;
+  }
+
+  // track and remove the DC offset
+  audio_dc += (int32_t)raw - (audio_dc >> 8);
+  int32_t x = (int32_t)raw - (audio_dc >> 8);
+  unsigned long t = atUs - window_start;
+
+  for (uint8_t band = 0; band < AUDIO_NUM_BANDS; band++) {
+    uint32_t phase = band_step[band] * (uint32_t)t; // wraps once per cycle
+    uint8_t i = phase >> 26;
+    band_re[band] += (x * audio_sine[(i + AUDIO_SINE_SIZE / 4) % AUDIO_SINE_SIZE]) >> 6;
+    band_im[band] += (x * audio_sine[i]) >> 6;
+  }
+
+  window_samples++;
+}
+
+// read a sample if one is due, stamped with when it was read. a late loop never
+// reads more than one, they'd all be stamped the same
+void audioSample() {
+  unsigned long now = micros();
+
+  if (now - last_sample_micros < audio_period_us) {
+    return;
+  }
+
+  last_sample_micros = now;
+  audioPushSample(audio_reader(), now);
+}
+
+uint8_t audioBandLevel(uint8_t band) {
+  return band_level[band];
+}
+
+// windows analyzed, and windows skipped for having too few samples
+uint32_t audioWindowCount() {
+  return audio_windows;
+}
+
+uint32_t audioSkippedWindows() {
+  return audio_skipped;
+}
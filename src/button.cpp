@@ -0,0 +1,283 @@
+#include <Arduino.h>
+#include "button.h"
+
+extern "C" {
+  #include "user_interface.h"
+}
+
+// edges are timestamped by the interrupt and decoded later from the loop, so
+// gestures are classified from when they happened, not when we got to them.
+// the interrupt only moves the head and the loop only moves the tail
+uint32_t edge_time[BUTTON_EDGE_BUFFER];
+bool edge_down[BUTTON_EDGE_BUFFER];
+volatile uint8_t edge_head = 0;
+volatile uint8_t edge_tail = 0;
+volatile bool isr_down = false;
+volatile uint16_t dropped_edges = 0;
+volatile bool wake_armed = false; // the pin is set to wake us on a low level
+
+// a burst of bouncing edges, settled once it has been quiet for BUTTON_DEBOUNCE_MS
+bool burst_pending = false;
+bool burst_down = false;
+uint32_t burst_start = 0;
+uint32_t burst_last = 0;
+
+// the debounced gesture decoder
+bool is_down = false;
+bool ignore_until_release = false;
+uint32_t down_at = 0;
+uint32_t up_at = 0;
+uint8_t clicks = 0;
+uint8_t holds_fired = 0;
+
+ButtonHandler click_handlers[BUTTON_MAX_CLICKS];
+ButtonHandler released_handler = NULL;
+unsigned long released_after = 0;
+ButtonHandler hold_handlers[BUTTON_MAX_HOLDS];
+unsigned long hold_after[BUTTON_MAX_HOLDS];
+uint8_t num_holds = 0;
+
+// called from the interrupt, so it's in IRAM and reads the gpio register directly
+bool ICACHE_RAM_ATTR readButton() {
+  return !GPIP(BUTTON_PIN); // wired to ground, pulled up
+}
+
+void ICACHE_RAM_ATTR catchBothEdges() {
+  GPC(BUTTON_PIN) = (GPC(BUTTON_PIN) & ~(0xF << GPCI)) | (CHANGE << GPCI);
+}
+
+void ICACHE_RAM_ATTR handleButtonEdge() {
+  // a low level fires for as long as the button is held, so once it has
+  // woken us go straight back to edges, or the press would never end
+  if (wake_armed) {
+    wake_armed = false;
+    catchBothEdges();
+  }
+
+  bool down = readButton();
+
+  if (down == isr_down) {
+    return;
+  }
+
+  uint8_t head = edge_head;
+
+  if ((uint8_t)(head - edge_tail) >= BUTTON_EDGE_BUFFER) {
+    dropped_edges++;
+    return;
+  }
+
+  edge_time[head & (BUTTON_EDGE_BUFFER - 1)] = millis();
+  edge_down[head & (BUTTON_EDGE_BUFFER - 1)] = down;
+  isr_down = down;
+  __asm__ __volatile__("" ::: "memory"); // the edge is written before the loop can see it
+  edge_head = head + 1;
+}
+
+bool popEdge(uint32_t* time, bool* down) {
+  uint8_t tail = edge_tail;
+
+  if (tail == edge_head) {
+    return false;
+  }
+
+  *time = edge_time[tail & (BUTTON_EDGE_BUFFER - 1)];
+  *down = edge_down[tail & (BUTTON_EDGE_BUFFER - 1)];
+  __asm__ __volatile__("" ::: "memory"); // and read before the interrupt can reuse its slot
+  edge_tail = tail + 1;
+
+  return true;
+}
+
+void emitClicks() {
+  uint8_t count = min(clicks, (uint8_t)BUTTON_MAX_CLICKS);
+  clicks = 0;
+
+  if (click_handlers[count - 1]) {
+    click_handlers[count - 1]();
+  }
+}
+
+// fire every hold whose time has come, in order
+void fireHolds(uint32_t heldFor) {
+  while (holds_fired < num_holds && heldFor >= hold_after[holds_fired]) {
+    clicks = 0; // a click just before it was the start of the hold, not a gesture of its own
+    hold_handlers[holds_fired++]();
+  }
+}
+
+void handlePress(uint32_t time) {
+  is_down = true;
+
+  if (ignore_until_release) {
+    return;
+  }
+
+  if (clicks && time - up_at > BUTTON_MULTI_CLICK_MS) {
+    emitClicks();
+  }
+
+  down_at = time;
+  holds_fired = 0;
+}
+
+void handleRelease(uint32_t time) {
+  is_down = false;
+
+  if (ignore_until_release) {
+    ignore_until_release = false;
+    return;
+  }
+
+  uint32_t heldFor = time - down_at;
+  fireHolds(heldFor); // any we didn't get to while it was held
+
+  if (holds_fired) {
+    return; // a hold is its own gesture
+  }
+
+  if (heldFor >= BUTTON_CLICK_MS) {
+    clicks = 0; // same for a long press
+
+    if (released_handler && heldFor >= released_after) {
+      released_handler();
+    }
+
+    return;
+  }
+
+  clicks++;
+  up_at = time;
+
+  if (clicks >= BUTTON_MAX_CLICKS) {
+    emitClicks();
+  }
+}
+
+void settleBurst() {
+  burst_pending = false;
+
+  if (burst_down == is_down) {
+    return; // bounced back to where it started
+  }
+
+  if (burst_down) {
+    handlePress(burst_start);
+  } else {
+    handleRelease(burst_start);
+  }
+}
+
+void decodeEdges(uint32_t now) {
+  uint32_t time;
+  bool down;
+
+  while (popEdge(&time, &down)) {
+    if (burst_pending && time - burst_last >= BUTTON_DEBOUNCE_MS) {
+      settleBurst();
+    }
+
+    if (!burst_pending) {
+      burst_pending = true;
+      burst_start = time;
+    }
+
+    burst_down = down;
+    burst_last = time;
+  }
+
+  if (burst_pending && now - burst_last >= BUTTON_DEBOUNCE_MS) {
+    settleBurst();
+  }
+}
+
+// start decoding from the current level, so a press in progress is never half a gesture
+void resetDecoder() {
+  uint32_t time;
+  bool down;
+
+  while (popEdge(&time, &down)) {}
+
+  burst_pending = false;
+  clicks = 0;
+  holds_fired = 0;
+  is_down = readButton();
+  ignore_until_release = is_down;
+}
+
+bool buttonBegin(unsigned long holdMs) {
+  pinMode(BUTTON_PIN, INPUT_PULLUP);
+  isr_down = readButton();
+  attachInterrupt(digitalPinToInterrupt(BUTTON_PIN), handleButtonEdge, CHANGE);
+  resetDecoder();
+  down_at = millis();
+
+  return buttonHeldFor(holdMs);
+}
+
+// block until released or held for ms since boot, true if it was held the whole time
+bool buttonHeldFor(unsigned long ms) {
+  while (readButton() && millis() - down_at < ms) {
+    delay(10);
+  }
+
+  return readButton();
+}
+
+bool buttonIsPressed() {
+  return is_down || burst_pending;
+}
+
+void buttonOnClicks(uint8_t count, ButtonHandler handler) {
+  if (count > 0 && count <= BUTTON_MAX_CLICKS) {
+    click_handlers[count - 1] = handler;
+  }
+}
+
+void buttonOnReleasedAfter(unsigned long ms, ButtonHandler handler) {
+  released_after = ms;
+  released_handler = handler;
+}
+
+// holds must be added shortest first
+void buttonOnHold(unsigned long ms, ButtonHandler handler) {
+  if (num_holds < BUTTON_MAX_HOLDS) {
+    hold_after[num_holds] = ms;
+    hold_handlers[num_holds++] = handler;
+  }
+}
+
+void buttonUpdate() {
+  uint32_t now = millis();
+  decodeEdges(now);
+
+  if (burst_pending) {
+    return; // the level isn't settled, so neither is the gesture
+  }
+
+  if (is_down && !ignore_until_release) {
+    fireHolds(now - down_at);
+  } else if (!is_down && clicks && now - up_at > BUTTON_MULTI_CLICK_MS) {
+    emitClicks();
+  }
+}
+
+uint16_t buttonDroppedEdges() {
+  return dropped_edges;
+}
+
+// the wakeup setting shares the pin's interrupt type, so it's only armed while idle
+void buttonArmWakeup() {
+  noInterrupts();
+  wifi_enable_gpio_wakeup(BUTTON_PIN, GPIO_PIN_INTR_LOLEVEL);
+  wake_armed = true;
+  interrupts(); // if it's already down, the edge handler disarms it right away
+}
+
+void buttonDisarmWakeup() {
+  noInterrupts();
+  wifi_disable_gpio_wakeup();
+  wake_armed = false;
+  catchBothEdges();
+  interrupts();
+}
@@ -0,0 +1,40 @@
+#include <Arduino.h>
+#include "events.h"
+
+// single producer, single consumer: only eventsPush() moves the head and only
+// eventsPop() moves the tail, so neither side ever needs a lock
+uint8_t events[EVENT_QUEUE_SIZE];
+volatile uint8_t event_head = 0;
+volatile uint8_t event_tail = 0;
+volatile uint16_t events_dropped = 0;
+
+bool eventsPush(uint8_t event) {
+  uint8_t head = event_head;
+
+  if ((uint8_t)(head - event_tail) >= EVENT_QUEUE_SIZE) {
+    events_dropped++;
+    return false;
+  }
+
+  events[head & (EVENT_QUEUE_SIZE - 1)] = event;
+  event_head = head + 1; // publish only once the slot is written
+
+  return true;
+}
+
+bool eventsPop(uint8_t* event) {
+  uint8_t tail = event_tail;
+
+  if (tail == event_head) {
+    return false;
+  }
+
+  *event = events[tail & (EVENT_QUEUE_SIZE - 1)];
+  event_tail = tail + 1;
+
+  return true;
+}
+
+uint16_t eventsDropped() {
+  return events_dropped;
+}
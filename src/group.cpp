@@ -0,0 +1,338 @@
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include <ESP8266WiFi.h>
+#include <LittleFS.h>
+#include <WiFiUdp.h>
+
+#include "group.h"
+
+WiFiUDP groupUdp;
+
+IPAddress group_address;
+uint16_t group_port = GROUP_DEFAULT_PORT;
+uint32_t group_mask = 0; // bit n is group n + 1
+bool group_joined = false;
+
+GroupCommandHandler group_on_command = NULL;
+const char* const* group_statuses = NULL;
+uint8_t group_num_statuses = 0;
+
+// last sequence number seen from each sender, so repeated packets only apply once
+struct GroupSender {
+  uint32_t ip;
+  uint32_t seq;
+  unsigned long seen;
+};
+
+GroupSender group_senders[GROUP_MAX_SENDERS];
+uint32_t group_applied = 0;
+uint32_t group_duplicates = 0;
+
+// true if seq is newer than anything this sender has sent before
+bool takeSequence(uint32_t ip, uint32_t seq) {
+  unsigned long now = millis();
+  GroupSender* oldest = &group_senders[0];
+
+  for (uint8_t i = 0; i < GROUP_MAX_SENDERS; i++) {
+    GroupSender* sender = &group_senders[i];
+
+    if (sender->ip == ip && sender->seen) {
+      // a sender that's been quiet for a while may have restarted its count
+      bool fresh = now - sender->seen > GROUP_SENDER_TTL || (int32_t)(seq - sender->seq) > 0;
+      sender->seen = now;
+
+      if (fresh) {
+        sender->seq = seq;
+      }
+
+      return fresh;
+    }
+
+    // an empty slot, or failing that whoever we heard from least recently
+    if (!sender->seen) {
+      oldest = sender;
+    } else if (oldest->seen && now - sender->seen > now - oldest->seen) {
+      oldest = sender;
+    }
+  }
+
+  oldest->ip = ip;
+  oldest->seq = seq;
+  oldest->seen = now;
+
+  return true;
+}
+
+String presetPath(uint8_t preset) {
+  char path[16];
+  snprintf(path, sizeof(path), GROUP_PRESET_FILE, preset);
+
+  return String(path);
+}
+
+// the saved body, or empty if there isn't one
+String loadPreset(uint8_t preset) {
+  if (preset < 1 || preset > GROUP_MAX_PRESETS) {
+    return String();
+  }
+
+  File f = LittleFS.open(presetPath(preset), "r");
+
+  if (!f) {
+    return String();
+  }
+
+  String body = f.readString();
+  f.close();
+
+  return body;
+}
+
+// turn a compact command into the same body POST /config takes
+bool commandToBody(uint8_t command, const uint8_t* args, size_t len, String& body) {
+  StaticJsonDocument<128> doc;
+
+  if (command == group_status && len == 1 && args[0] < group_num_statuses) {
+    doc["status"] = FPSTR(pgm_read_ptr(&group_statuses[args[0]]));
+  } else if (command == group_color && (len == 3 || len == 4)) {
+    JsonArray color = doc.createNestedArray("color");
+
+    for (uint8_t i = 0; i < len; i++) {
+      color.add(args[i]);
+    }
+  } else if (command == group_mode && len == 1) {
+    doc["mode_num"] = args[0];
+  } else if (command == group_config && len > 0) {
+    body.concat((const char*)args, len);
+    return true;
+  } else if (command == group_preset && len == 1) {
+    body = loadPreset(args[0]);
+    return body.length() > 0;
+  } else {
+    return false;
+  }
+
+  serializeJson(doc, body);
+  return true;
+}
+
+// returns true if the packet was applied
+bool handleGroupPacket(const uint8_t* packet, size_t len, uint32_t from) {
+  if (len < GROUP_HEADER_SIZE || packet[0] != 'S' || packet[1] != 'L' || packet[2] != GROUP_VERSION) {
+    return false;
+  }
+
+  uint8_t group = packet[3];
+
+  if (group > GROUP_MAX_GROUPS || (group && !(group_mask & (1UL << (group - 1))))) {
+    return false; // not one of ours
+  }
+
+  uint32_t seq = ((uint32_t)packet[4] << 24) | ((uint32_t)packet[5] << 16) | ((uint32_t)packet[6] << 8) | packet[7];
+
+  if (!takeSequence(from, seq)) {
+    group_duplicates++;
+    return false;
+  }
+
+  String body;
+
+  if (!commandToBody(packet[8], packet + GROUP_HEADER_SIZE, len - GROUP_HEADER_SIZE, body)) {
+    Serial.println(F("[ERROR] Unknown group command or preset"));
+    return false;
+  }
+
+  Serial.print(F("[GROUP]: "));
+  Serial.println(body);
+
+  group_applied++;
+  group_on_command(body);
+
+  return true;
+}
+
+void loadGroupConfig() {
+  File f = LittleFS.open(GROUP_CONFIG_FILE, "r");
+
+  if (!f) {
+    return;
+  }
+
+  StaticJsonDocument<512> config;
+  DeserializationError error = deserializeJson(config, f);
+  f.close();
+
+  if (error) {
+    Serial.println(F("[ERROR] Could not read group config"));
+    return;
+  }
+
+  groupConfigure(config["address"] | GROUP_DEFAULT_ADDRESS, config["port"] | GROUP_DEFAULT_PORT, config["mask"] | 0UL, false);
+}
+
+void saveGroupConfig() {
+  File f = LittleFS.open(GROUP_CONFIG_FILE, "w");
+
+  if (!f) {
+    Serial.println(F("[ERROR] Could not save group config"));
+    return;
+  }
+
+  StaticJsonDocument<128> config;
+  config["address"] = group_address.toString();
+  config["port"] = group_port;
+  config["mask"] = group_mask;
+  serializeJson(config, f);
+  f.close();
+}
+
+void groupSetup(GroupCommandHandler onCommand, const char* const* statuses, uint8_t numStatuses) {
+  group_on_command = onCommand;
+  group_statuses = statuses;
+  group_num_statuses = numStatuses;
+  group_address.fromString(GROUP_DEFAULT_ADDRESS);
+
+  if (LittleFS.begin()) {
+    loadGroupConfig();
+  }
+}
+
+bool groupConfigure(String address, uint16_t port, uint32_t groups, bool persist) {
+  IPAddress newAddress;
+
+  // multicast lives in 224.0.0.0/4
+  if (!newAddress.fromString(address.c_str()) || (newAddress[0] & 0xf0) != 224) {
+    return false;
+  }
+
+  group_address = newAddress;
+  group_port = port ? port : GROUP_DEFAULT_PORT;
+  group_mask = groups;
+  groupRejoin();
+
+  if (persist) {
+    saveGroupConfig();
+  }
+
+  return true;
+}
+
+// the membership doesn't survive a reconnect, so join again on the next loop
+void groupRejoin() {
+  if (group_joined) {
+    groupUdp.stop();
+  }
+
+  group_joined = false;
+}
+
+String groupGetConfigAsJson() {
+  StaticJsonDocument<768> config;
+  config["address"] = group_address.toString();
+  config["port"] = group_port;
+  JsonArray groups = config.createNestedArray("groups");
+
+  for (uint8_t i = 0; i < GROUP_MAX_GROUPS; i++) {
+    if (group_mask & (1UL << i)) {
+      groups.add(i + 1);
+    }
+  }
+
+  config["joined"] = group_joined;
+  config["applied"] = group_applied;
+  config["duplicates"] = group_duplicates;
+
+  String output;
+  serializeJson(config, output);
+
+  return output;
+}
+
+bool groupSavePreset(uint8_t preset, String body) {
+  if (preset < 1 || preset > GROUP_MAX_PRESETS) {
+    return false;
+  }
+
+  if (!body.length()) {
+    LittleFS.remove(presetPath(preset));
+    return true;
+  }
+
+  File f = LittleFS.open(presetPath(preset), "w");
+
+  if (!f) {
+    Serial.println(F("[ERROR] Could not save preset"));
+    return false;
+  }
+
+  f.print(body);
+  f.close();
+
+  return true;
+}
+
+// the bodies were checked when they were saved, so they go out as they are
+String groupGetPresetsAsJson() {
+  String output = "{";
+
+  for (uint8_t preset = 1; preset <= GROUP_MAX_PRESETS; preset++) {
+    String body = loadPreset(preset);
+
+    if (!body.length()) {
+      continue;
+    }
+
+    if (output.length() > 1) {
+      output += ',';
+    }
+
+    output += '"';
+    output += preset;
+    output += "\":";
+    output += body;
+  }
+
+  output += '}';
+
+  return output;
+}
+
+// returns true if any command was applied
+bool groupLoop() {
+  if (!group_on_command || WiFi.status() != WL_CONNECTED) {
+    return false;
+  }
+
+  if (!group_joined) {
+    group_joined = groupUdp.beginMulticast(WiFi.localIP(), group_address, group_port);
+
+    if (!group_joined) {
+      return false;
+    }
+  }
+
+  uint8_t packet[GROUP_MAX_PACKET];
+  bool applied = false;
+
+  // bounded, so a flood of packets can't hold up the frame
+  for (uint8_t i = 0; i < GROUP_PACKETS_PER_LOOP; i++) {
+    int size = groupUdp.parsePacket();
+
+    if (size <= 0) {
+      break;
+    }
+
+    if (size > GROUP_MAX_PACKET) {
+      groupUdp.flush();
+      continue;
+    }
+
+    int len = groupUdp.read(packet, size);
+
+    if (len > 0) {
+      applied |= handleGroupPacket(packet, len, groupUdp.remoteIP());
+    }
+  }
+
+  return applied;
+}
@@ -6,7 +6,7 @@
 String makeErrorJson(String errorMessage) {
   String errorJson = makeSimpleJson("error", errorMessage.c_str());
 
-  Serial.print("[ERROR]: ");
+  Serial.print(F("[ERROR]: "));
   Serial.println(errorJson);
 
   return errorJson;
@@ -33,3 +33,52 @@ String makeSimpleJson(String key, String value) {
 
   return jChar;
 }
+
+int hexNibble(char c) {
+  if (c >= '0' && c <= '9') {
+    return c - '0';
+  }
+  if (c >= 'a' && c <= 'f') {
+    return c - 'a' + 10;
+  }
+  if (c >= 'A' && c <= 'F') {
+    return c - 'A' + 10;
+  }
+
+  return -1;
+}
+
+// returns the number of bytes written, or -1 if the string is not valid hex
+int hexToBytes(String hex, uint8_t* bytes, size_t maxLen) {
+  size_t len = hex.length() / 2;
+
+  if ((hex.length() % 2) || len > maxLen) {
+    return -1;
+  }
+
+  for (size_t i = 0; i < len; i++) {
+    int hi = hexNibble(hex[i * 2]);
+    int lo = hexNibble(hex[i * 2 + 1]);
+
+    if (hi < 0 || lo < 0) {
+      return -1;
+    }
+
+    bytes[i] = (hi << 4) | lo;
+  }
+
+  return len;
+}
+
+String bytesToHex(const uint8_t* bytes, size_t len) {
+  const char digits[] = "0123456789abcdef";
+  String hex;
+  hex.reserve(len * 2);
+
+  for (size_t i = 0; i < len; i++) {
+    hex += digits[bytes[i] >> 4];
+    hex += digits[bytes[i] & 0x0f];
+  }
+
+  return hex;
+}
@@ -0,0 +1,317 @@
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include <LittleFS.h>
+#include <time.h>
+
+#include "history.h"
+
+#define HISTORY_NONE 0xff
+#define HISTORY_CLOCK_SET 1600000000UL // anything earlier means sntp hasn't answered yet
+
+struct HistoryRecord {
+  uint32_t at; // epoch seconds, 0 if the clock wasn't set yet
+  uint8_t status;
+  uint8_t unused[3];
+};
+
+struct HistoryDay {
+  uint32_t key; // local year * 1000 + day of the year, 0 if unused
+  uint32_t start; // epoch seconds of the first time counted in this day
+  uint32_t seconds[HISTORY_MAX_STATUSES];
+};
+
+// everything that is saved, status ids index names and totals
+struct HistoryLog {
+  uint32_t magic;
+  uint8_t builtins;
+  uint8_t head;
+  uint8_t count;
+  uint8_t day;
+  char custom[HISTORY_MAX_CUSTOM][HISTORY_NAME_SIZE];
+  uint32_t totals[HISTORY_MAX_STATUSES];
+  HistoryDay days[HISTORY_DAYS];
+  HistoryRecord records[HISTORY_SIZE];
+};
+
+HistoryLog history;
+
+const char* const* history_builtin = NULL;
+uint8_t history_current = HISTORY_NONE;
+uint32_t history_current_at = 0;
+unsigned long history_last_fold = 0;
+unsigned long history_carry_ms = 0;
+unsigned long history_last_save = 0;
+bool history_dirty = false;
+
+// built in names are in flash, custom ones are in the log
+PGM_P builtinName(uint8_t id) {
+  return (PGM_P)pgm_read_ptr(&history_builtin[id]);
+}
+
+bool hasName(uint8_t id, const char* name) {
+  if (id < history.builtins) {
+    return !strcmp_P(name, builtinName(id));
+  }
+
+  if (id >= HISTORY_MAX_BUILTIN && id < HISTORY_MAX_STATUSES) {
+    return !strncmp(history.custom[id - HISTORY_MAX_BUILTIN], name, HISTORY_NAME_SIZE - 1);
+  }
+
+  return false;
+}
+
+// names from flash are copied into the document, names from the log are kept by pointer
+void setName(JsonObject obj, const char* key, uint8_t id) {
+  if (id < history.builtins) {
+    obj[key] = FPSTR(builtinName(id));
+  } else if (id >= HISTORY_MAX_BUILTIN && id < HISTORY_MAX_STATUSES) {
+    obj[key] = (const char*)history.custom[id - HISTORY_MAX_BUILTIN];
+  } else {
+    obj[key] = (const char*)NULL;
+  }
+}
+
+void setTotal(JsonObject totals, uint8_t id, uint32_t seconds) {
+  if (!seconds) {
+    return;
+  }
+
+  if (id < history.builtins) {
+    totals[FPSTR(builtinName(id))] = seconds;
+  } else if (id >= HISTORY_MAX_BUILTIN && id < HISTORY_MAX_STATUSES) {
+    totals[(const char*)history.custom[id - HISTORY_MAX_BUILTIN]] = seconds;
+  }
+}
+
+uint32_t epochNow() {
+  time_t now = time(NULL);
+  return now >= (time_t)HISTORY_CLOCK_SET ? now : 0;
+}
+
+// the day bucket for right now, NULL until the clock is set
+HistoryDay* today() {
+  time_t now = epochNow();
+
+  if (!now) {
+    return NULL;
+  }
+
+  struct tm local;
+  localtime_r(&now, &local);
+  uint32_t key = (local.tm_year + 1900) * 1000UL + local.tm_yday;
+  HistoryDay* day = &history.days[history.day];
+
+  if (day->key != key) {
+    history.day = (history.day + 1) % HISTORY_DAYS;
+    day = &history.days[history.day];
+    memset(day, 0, sizeof(HistoryDay));
+    day->key = key;
+    day->start = now;
+  }
+
+  return day;
+}
+
+// add the time since the last fold to the current status, so totals are always up to date
+void fold() {
+  unsigned long now = millis();
+  history_carry_ms += now - history_last_fold;
+  history_last_fold = now;
+
+  uint32_t seconds = history_carry_ms / 1000;
+  history_carry_ms %= 1000;
+
+  if (!seconds || history_current == HISTORY_NONE) {
+    return;
+  }
+
+  history.totals[history_current] += seconds;
+  HistoryDay* day = today();
+
+  if (day) {
+    day->seconds[history_current] += seconds;
+  }
+}
+
+// the id for a status name, taking over the least used custom slot if they're all full
+uint8_t intern(const char* status) {
+  for (uint8_t i = 0; i < history.builtins; i++) {
+    if (hasName(i, status)) {
+      return i;
+    }
+  }
+
+  uint8_t slot = 0;
+  uint32_t slotWeight = UINT32_MAX;
+
+  for (uint8_t i = 0; i < HISTORY_MAX_CUSTOM; i++) {
+    uint8_t id = HISTORY_MAX_BUILTIN + i;
+
+    if (!strncmp(history.custom[i], status, HISTORY_NAME_SIZE - 1)) {
+      return id;
+    }
+
+    // an empty slot, or failing that the status with the least time
+    uint32_t weight = history.custom[i][0] ? history.totals[id] + 1 : 0;
+
+    if (id != history_current && weight < slotWeight) {
+      slot = i;
+      slotWeight = weight;
+    }
+  }
+
+  uint8_t id = HISTORY_MAX_BUILTIN + slot;
+
+  // forget everything about the status that used to live here
+  history.totals[id] = 0;
+
+  for (uint8_t i = 0; i < HISTORY_DAYS; i++) {
+    history.days[i].seconds[id] = 0;
+  }
+
+  for (uint8_t i = 0; i < HISTORY_SIZE; i++) {
+    if (history.records[i].status == id) {
+      history.records[i].status = HISTORY_NONE;
+    }
+  }
+
+  strlcpy(history.custom[slot], status, HISTORY_NAME_SIZE);
+
+  return id;
+}
+
+void saveHistory() {
+  File f = LittleFS.open(HISTORY_FILE, "w");
+
+  if (!f) {
+    Serial.println(F("[ERROR] Could not save status history"));
+    return;
+  }
+
+  f.write((const uint8_t*)&history, sizeof(history));
+  f.close();
+
+  history_last_save = millis();
+  history_dirty = false;
+}
+
+void loadHistory() {
+  File f = LittleFS.open(HISTORY_FILE, "r");
+
+  if (!f) {
+    return;
+  }
+
+  uint8_t builtins = history.builtins;
+  size_t len = f.read((uint8_t*)&history, sizeof(history));
+  f.close();
+
+  // a different layout or set of built in statuses starts over
+  if (len != sizeof(history) || history.magic != HISTORY_MAGIC || history.builtins != builtins) {
+    Serial.println(F("[INFO] Starting a new status history"));
+    memset(&history, 0, sizeof(history));
+    history.magic = HISTORY_MAGIC;
+    history.builtins = builtins;
+  }
+}
+
+void historySetup(const char* const* statuses, uint8_t numStatuses) {
+  memset(&history, 0, sizeof(history));
+  history.magic = HISTORY_MAGIC;
+  history.builtins = min(numStatuses, (uint8_t)HISTORY_MAX_BUILTIN);
+  history_builtin = statuses;
+  history_last_fold = millis();
+
+  configTime(HISTORY_TZ, "pool.ntp.org", "time.nist.gov"); // days need the wall clock
+
+  if (LittleFS.begin()) {
+    loadHistory();
+  }
+}
+
+void historyLoop(uint8_t status, const char* custom) {
+  unsigned long now = millis();
+  bool builtin = status < history.builtins;
+
+  if (builtin ? status != history_current : !hasName(history_current, custom)) {
+    fold(); // close out the old status
+
+    history_current = builtin ? status : intern(custom);
+    history_current_at = epochNow();
+
+    HistoryRecord* record = &history.records[history.head];
+    record->at = history_current_at;
+    record->status = history_current;
+    history.head = (history.head + 1) % HISTORY_SIZE;
+    history.count = min(history.count + 1, HISTORY_SIZE);
+    history_dirty = true;
+  } else if (now - history_last_fold >= HISTORY_FOLD_MS) {
+    fold();
+  }
+
+  // changes are saved within a minute, running totals every 10 minutes
+  if ((history_dirty && now - history_last_save >= HISTORY_SAVE_MS) || now - history_last_save >= HISTORY_SYNC_MS) {
+    saveHistory();
+  }
+}
+
+String historyGetAsJson() {
+  fold();
+
+  DynamicJsonDocument doc(4096);
+  char date[11];
+
+  JsonObject root = doc.to<JsonObject>();
+  setName(root, "status", history_current);
+  root["since"] = history_current_at;
+
+  JsonObject totals = root.createNestedObject("totals");
+
+  for (uint8_t id = 0; id < HISTORY_MAX_STATUSES; id++) {
+    setTotal(totals, id, history.totals[id]);
+  }
+
+  // newest day first
+  JsonArray days = root.createNestedArray("days");
+
+  for (uint8_t i = 0; i < HISTORY_DAYS; i++) {
+    HistoryDay* day = &history.days[(history.day + HISTORY_DAYS - i) % HISTORY_DAYS];
+
+    if (!day->key) {
+      continue;
+    }
+
+    time_t start = day->start;
+    struct tm local;
+    localtime_r(&start, &local);
+    strftime(date, sizeof(date), "%Y-%m-%d", &local);
+
+    JsonObject entry = days.createNestedObject();
+    entry["date"] = date; // copied, the buffer is reused
+    JsonObject seconds = entry.createNestedObject("totals");
+
+    for (uint8_t id = 0; id < HISTORY_MAX_STATUSES; id++) {
+      setTotal(seconds, id, day->seconds[id]);
+    }
+  }
+
+  // newest change first
+  JsonArray recent = root.createNestedArray("recent");
+
+  for (uint8_t i = 1; i <= min((uint8_t)HISTORY_RECENT, history.count); i++) {
+    HistoryRecord* record = &history.records[(history.head + HISTORY_SIZE - i) % HISTORY_SIZE];
+
+    if (record->status == HISTORY_NONE) {
+      continue;
+    }
+
+    JsonObject entry = recent.createNestedObject();
+    setName(entry, "status", record->status);
+    entry["at"] = record->at;
+  }
+
+  String output;
+  serializeJson(doc, output);
+
+  return output;
+}
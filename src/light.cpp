@@ -1,24 +1,60 @@
 #include <Arduino.h>
 #include <Adafruit_NeoPixel.h>
+#include "audio.h"
 #include "light.h"
-
+#include "pixels.h"
+#include "rng.h"
+#include "particles.h"
+#include "pattern.h"
+#include "segments.h"
+
+// the strip profile comes from the platformio.ini environment
+#ifndef LED_PIN
 #define LED_PIN  0 //D3
+#endif
+#ifndef LED_COUNT
 #define LED_COUNT 10
-
-Adafruit_NeoPixel strip(LED_COUNT, LED_PIN, NEO_GRB + NEO_KHZ800);
-uint8_t last_r = 0;
-uint8_t last_g = 0;
-uint8_t last_b = 0;
-uint8_t last_a = 0;
-uint8_t last_speed = 3;
+#endif
+#ifndef LED_TYPE
+#define LED_TYPE NEO_GRB
+#endif
+#ifndef LED_MA_BUDGET
+#define LED_MA_BUDGET 400 // what the supply can spare for the leds
+#endif
+#define LED_MA_PER_CHANNEL 20 // one color of one led at full
+#define LED_MA_IDLE (LED_COUNT * 1) // every led draws about 1mA even when dark
+
+Adafruit_NeoPixel strip(LED_COUNT, LED_PIN, LED_TYPE + NEO_KHZ800);
+typedef PixelWriter<LED_TYPE, LED_COUNT> Pixels;
 int numStripPixels = strip.numPixels();
 uint32_t stripColor = strip.Color(0, 0, 0);
-bool in_delay = false;
-uint8_t last_neo_mode = off_mode;
+bool frame_done = false;
+uint8_t neo_a = 0;
+uint16_t neo_rate = NEO_RATE_ONE; // speed multiplier, in 1/256ths
+unsigned long neo_phase = 0; // animation time owed, in 1/256 ms
+unsigned long last_phase_millis = 0;
+uint8_t current_neo_mode = MODE_END; // nothing is drawn until the first mode change
+
+// every effect, in the order next and prev step through them
+const uint8_t NEO_EFFECTS[] PROGMEM = {
+  solid_mode,
+  breath_mode,
+  marquee_mode,
+  theater_mode,
+  rainbow_mode,
+  rainbow_marquee_mode,
+  rainbow_theater_mode,
+  sparkle_mode,
+  twinkle_mode,
+  fire_mode,
+  meteor_mode,
+  audio_mode
+};
+bool neo_restart = false; // the mode changed, start the animation over
+bool neo_redraw = false; // the color or brightness changed, redraw static frames
 unsigned long neo_step_i = 0;
 unsigned long neo_step_i_max = 0;
 unsigned long neo_mode_delay = 10;
-unsigned long last_delay_millis = 0;
 int neo_step_j = 0;
 int neo_step_j_max = 0;
 int neo_step_k = 0;
@@ -26,261 +62,482 @@ int neo_step_k_max = 0;
 int firstPixelHue = 0;
 uint8_t minBreathBrightness = 5;
 uint8_t BREATH_SPEED = 25; // larger number makes it slower, smaller number makes it faster. 25 is good
-uint8_t MAX_ALPHA = 150;
-bool _neo_off = false;
+
+// time and frame output go through here, so a recorder or a fake clock can stand in
+NeoClock neo_clock = millis;
+NeoFrameHook neo_frame_hook = NULL;
+bool neo_output = true; // off while replaying, frames still reach the hook
+bool neo_catching_up = false; // steps that are owed but never shown
+uint32_t neo_frames = 0;
+uint32_t neo_steps = 0;
+uint32_t neo_dropped_steps = 0;
+
+// current limiting, the unlimited frame is kept so effects can build on it
+uint8_t neo_unlimited[LED_COUNT * Pixels::BYTES];
+uint16_t neo_ma = 0;
+uint16_t neo_limit_scale = 256;
+uint32_t neo_limited_frames = 0;
 
 void neoSetup() {
   strip.begin();           // INITIALIZE NeoPixel strip object (REQUIRED)
   strip.show();            // Turn OFF all pixels ASAP
   strip.setBrightness(50); // Set BRIGHTNESS to about 1/5 (max = 255)
-  Serial.print("Number of LEDs: ");
+  Serial.print(F("Number of LEDs: "));
   Serial.println(LED_COUNT);
 }
 
-void updateValues(uint8_t r, uint8_t g, uint8_t b, uint8_t a, uint8_t neo_mode) {
-  if (r != last_r)
+void neoSetClock(NeoClock clock) {
+  neo_clock = clock ? clock : millis;
+}
+
+void neoSetFrameHook(NeoFrameHook hook) {
+  neo_frame_hook = hook;
+}
+
+// replays render without touching the strip
+void neoSetOutput(bool enabled) {
+  neo_output = enabled;
+}
+
+// forget the current mode, so the next neoSetMode() starts it over even if it's the same one
+void neoRestart() {
+  current_neo_mode = MODE_END;
+}
+
+unsigned long neoNow() {
+  return neo_clock();
+}
+
+// push the frame to the strip, dimmed to fit the current budget
+void neoShow() {
+  if (neo_catching_up) {
+    return;
+  }
+
+  uint32_t ma = pixelsMilliamps(Pixels::load(strip), LED_MA_PER_CHANNEL, LED_MA_IDLE);
+  uint16_t scale = pixelsLimitScale(ma, LED_MA_BUDGET, LED_MA_IDLE);
+  unsigned long showUs;
+
+  if (scale < 256) {
+    uint8_t* pixels = strip.getPixels();
+
+    memcpy(neo_unlimited, pixels, sizeof(neo_unlimited));
+    Pixels::scale(strip, scale);
+    showUs = micros();
+
+    if (neo_output) {
+      strip.show();
+    }
+
+    showUs = micros() - showUs;
+    memcpy(pixels, neo_unlimited, sizeof(neo_unlimited));
+
+    ma = (ma - LED_MA_IDLE) * scale / 256 + LED_MA_IDLE;
+    neo_limited_frames++;
+  } else {
+    showUs = micros();
+
+    if (neo_output) {
+      strip.show();
+    }
+
+    showUs = micros() - showUs;
+  }
+
+  neo_ma = ma;
+  neo_limit_scale = scale;
+  neo_frames++;
+
+  if (neo_frame_hook) {
+    neo_frame_hook(neo_clock(), showUs);
+  }
+}
+
+// the last frame as it sits in the strip's buffer, in wire order with brightness applied
+const uint8_t* neoPixels() {
+  return strip.getPixels();
+}
+
+uint16_t neoPixelBytes() {
+  return LED_COUNT * Pixels::BYTES;
+}
+
+uint8_t neoBytesPerPixel() {
+  return Pixels::BYTES;
+}
+
+// how much the current limit dimmed the last frame on its way out, 256 is not at all
+uint16_t neoLimitScale() {
+  return neo_limit_scale;
+}
+
+uint8_t neoCurrentMode() {
+  return current_neo_mode;
+}
+
+uint8_t neoEffectCount() {
+  return sizeof(NEO_EFFECTS);
+}
+
+uint8_t neoEffectAt(uint8_t i) {
+  return pgm_read_byte(&NEO_EFFECTS[i]);
+}
+
+// position in the effect list, -1 for off, pattern and segments
+int8_t neoEffectIndex(uint8_t mode) {
+  for (uint8_t i = 0; i < sizeof(NEO_EFFECTS); i++) {
+    if (neoEffectAt(i) == mode) {
+      return i;
+    }
+  }
+
+  return -1;
+}
+
+bool neoIsEffect(uint8_t mode) {
+  return neoEffectIndex(mode) >= 0;
+}
+
+void neoSetPixel(uint16_t i, uint32_t color) {
+  Pixels::set(strip, i, color);
+}
+
+void neoFill(uint32_t color, uint16_t first, uint16_t count) {
+  Pixels::fill(strip, color, first, count);
+}
+
+uint16_t neoEstimatedMilliamps() {
+  return neo_ma;
+}
+
+uint16_t neoMilliampBudget() {
+  return LED_MA_BUDGET;
+}
+
+uint32_t neoLimitedFrameCount() {
+  return neo_limited_frames;
+}
+
+uint32_t neoFrameCount() {
+  return neo_frames;
+}
+
+// effect steps advanced, shown or not, for checking cycle periods against the clock
+uint32_t neoStepCount() {
+  return neo_steps;
+}
+
+// the renderer only changes in response to these, it never polls the app state
+
+void neoSetColor(uint8_t r, uint8_t g, uint8_t b) {
+  Serial.print(F("Color changed to ["));
+  Serial.print(r);
+  Serial.print(F(", "));
+  Serial.print(g);
+  Serial.print(F(", "));
+  Serial.print(b);
+  Serial.println(F("]"));
+
+  stripColor = strip.Color(r, g, b);
+  neo_redraw = true;
+}
+
+// brightness comes in as 0 to NEO_BRIGHTNESS_MAX and uses the strip's full range,
+// neoShow() keeps the draw within budget
+void neoSetBrightness(uint8_t a) {
+  uint8_t alpha = min(a, (uint8_t)NEO_BRIGHTNESS_MAX) * 255 / NEO_BRIGHTNESS_MAX;
+
+  Serial.print(F("Alpha changed to "));
+  Serial.println(alpha);
+
+  if (current_neo_mode == breath_mode) {
+    neo_step_i_max = (alpha - minBreathBrightness) * 2;
+    neo_mode_delay = 50;
+  } else {
+    strip.setBrightness(alpha);
+  }
+
+  neo_a = alpha;
+  neo_redraw = true;
+}
+
+// speeds 1 to 5 as rates: 1/3x, 1/2x, 1x, 2x, 3x
+const uint16_t SPEED_RATES[] = { NEO_RATE_ONE / 3, NEO_RATE_ONE / 2, NEO_RATE_ONE, NEO_RATE_ONE * 2, NEO_RATE_ONE * 3 };
+
+uint16_t neoRateForSpeed(uint8_t speed) {
+  return SPEED_RATES[constrain(speed, (uint8_t)1, (uint8_t)5) - 1];
+}
+
+void neoSetSpeed(uint8_t speed) {
+  neoSetRate(neoRateForSpeed(speed));
+}
+
+void neoSetRate(uint16_t rate) {
+  Serial.print(F("Rate changed to "));
+  Serial.print(rate / (float)NEO_RATE_ONE);
+  Serial.println(F("x"));
+
+  neo_rate = constrain(rate, (uint16_t)NEO_RATE_MIN, (uint16_t)NEO_RATE_MAX);
+}
+
+void neoSetMode(uint8_t neo_mode) {
+  if (neo_mode == current_neo_mode) {
+    return;
+  }
+
+  Serial.print(F("neo_mode changed from "));
+  Serial.print(current_neo_mode);
+  Serial.print(F(" to "));
+  Serial.println(neo_mode);
+
+  current_neo_mode = neo_mode;
+  neo_step_i = 0; // reset step for animation change
+  last_phase_millis = neoNow();
+  neo_restart = true;
+
+  if (neo_mode == off_mode)
   {
-    last_r = r;
+    strip.clear();
+    neoShow();
+    return;
   }
-  if (g != last_g)
+
+  if (neo_mode != breath_mode)
   {
-    last_g = g;
+    strip.setBrightness(neo_a); // breath leaves the strip at whatever level it was on
   }
-  if (b != last_b)
+
+  if (neo_mode == breath_mode)
   {
-    last_b = b;
+    neo_step_i_max = (neo_a - minBreathBrightness) * 2;
+    neo_mode_delay = 50;
   }
-  if (a != last_a)
+  else if (neo_mode == marquee_mode)
   {
-    last_a = a;
+    neo_step_i_max = numStripPixels * 2;
+    neo_mode_delay = 100;
   }
-  if (neo_mode != last_neo_mode)
+  else if (neo_mode == rainbow_marquee_mode)
+  {
+    neo_step_i_max = 5*65536;
+    neo_step_j_max = numStripPixels;
+    neo_mode_delay = 10;
+  }
+  else if (neo_mode == rainbow_mode)
+  {
+    neo_step_i_max = 65536;
+    neo_mode_delay = 100;
+  }
+  else if (neo_mode == theater_mode)
   {
-    last_neo_mode = neo_mode;
+    neo_step_i_max = 10;
+    neo_step_j_max = 3;
+    neo_step_k_max = numStripPixels;
+    neo_mode_delay = 100;
+  }
+  else if (neo_mode == rainbow_theater_mode)
+  {
+    neo_step_i_max = 30;
+    neo_step_j_max = 3;
+    neo_step_k_max = numStripPixels;
+    neo_mode_delay = 100;
+  }
+  else if (neo_mode == sparkle_mode)
+  {
+    neo_mode_delay = 50;
+  }
+  else if (neo_mode == twinkle_mode || neo_mode == fire_mode || neo_mode == meteor_mode)
+  {
+    particlesReset(numStripPixels);
+    neo_mode_delay = 30;
+  }
+  else if (neo_mode == audio_mode)
+  {
+    neo_mode_delay = 20;
   }
 }
 
-bool colorsChanged(uint8_t r, uint8_t g, uint8_t b) {
-  return (!(r == last_r && g == last_g && b == last_b));
+unsigned long getDelayForSpeed(unsigned long currentDelay, uint8_t neo_speed) {
+  switch (neo_speed)
+  {
+  case 1:
+    return currentDelay * 3;
+  case 2:
+    return currentDelay * 2;
+  case 4:
+    return currentDelay / 2;
+  case 5:
+    return currentDelay / 3;
+  default:
+    return currentDelay;
+  }
 }
 
-bool handleColorChange(uint8_t r, uint8_t g, uint8_t b) {
-  if (colorsChanged(r, g, b)) {
-    Serial.print("Colors change from: [");
-    Serial.print(last_r);
-    Serial.print(", ");
-    Serial.print(last_g);
-    Serial.print(", ");
-    Serial.print(last_b);
-    Serial.print("] to [");
-    Serial.print(r);
-    Serial.print(", ");
-    Serial.print(g);
-    Serial.print(", ");
-    Serial.print(b);
-    Serial.println("]");
-    stripColor = strip.Color(r, g, b);
-    last_r = r;
-    last_g = g;
-    last_b = b;
+// a frame of the current effect costs its delay at 1x, in 1/256 ms
+unsigned long getFrameCost() {
+  unsigned long cost = neo_mode_delay << 8;
 
-    return true;
+  // scale the delay so that the breath cycle is roughly the same duration regardless of the brightness
+  if (current_neo_mode == breath_mode) {
+    int divisor = ((neo_a - minBreathBrightness) / BREATH_SPEED);
+    divisor = max(1, divisor); // ensure we don't have a 0 divisor
+    cost /= divisor;
   }
 
-  return false;
+  return cost;
 }
 
-bool handleBrightnessChange(uint8_t a, uint8_t neo_mode) {
-  uint8_t alpha = min(a, MAX_ALPHA);
-
-  if (alpha != last_a) {
-    Serial.print("Alpha changed from ");
-    Serial.print(last_a);
-    Serial.print(" to ");
-    Serial.println(alpha);
-
-    if (neo_mode == breath_mode) {
-      neo_step_i_max = (alpha - minBreathBrightness) * 2;
-      neo_mode_delay = 50;
-    } else {
-      strip.setBrightness(alpha);
-    }
+// steps that are due but not rendered yet, only timed effects owe any
+uint32_t neoOwedSteps() {
+  if (current_neo_mode == solid_mode || !neoIsEffect(current_neo_mode)) {
+    return 0;
+  }
 
-    last_a = alpha;
+  return neo_phase / getFrameCost();
+}
 
-    return true;
-  }
+// steps given up on because the loop fell too far behind
+uint32_t neoDroppedStepCount() {
+  return neo_dropped_steps;
+}
 
-  return false;
+void endFrame() {
+  frame_done = true;
 }
 
-void handleResetNeoStep(uint8_t neo_mode) {
-  if (neo_mode != last_neo_mode)
+// some effects draw a pixel per call, so keep calling until the frame is done
+void renderFrame(uint8_t neo_mode) {
+  frame_done = false;
+
+  for (int i = 0; !frame_done && i <= numStripPixels * 2 + 2; i++)
   {
-    neo_step_i = 0; // reset step for animation change
-    in_delay = false;
-    Serial.print("neo_mode changed from ");
-    Serial.print(last_neo_mode);
-    Serial.print(" to ");
-    Serial.println(neo_mode);
-    
     if (neo_mode == breath_mode)
     {
-      neo_step_i_max = (last_a - minBreathBrightness) * 2;
-      neo_mode_delay = 50;
+      breathe();
     }
     else if (neo_mode == marquee_mode)
     {
-      neo_step_i_max = numStripPixels * 2;
-      neo_mode_delay = 100;
+      marquee();
     }
     else if (neo_mode == rainbow_marquee_mode)
     {
-      neo_step_i_max = 5*65536;
-      neo_step_j_max = numStripPixels;
-      neo_mode_delay = 10;
+      rainbowMarquee();
     }
     else if (neo_mode == rainbow_mode)
     {
-      neo_step_i_max = 65536;
-      neo_mode_delay = 100;
+      rainbow();
     }
     else if (neo_mode == theater_mode)
     {
-      neo_step_i_max = 10;
-      neo_step_j_max = 3;
-      neo_step_k_max = numStripPixels;
-      neo_mode_delay = 100;
+      theater();
     }
     else if (neo_mode == rainbow_theater_mode)
     {
-      neo_step_i_max = 30;
-      neo_step_j_max = 3;
-      neo_step_k_max = numStripPixels;
-      neo_mode_delay = 100;
+      rainbowTheater();
+    }
+    else if (neo_mode == sparkle_mode)
+    {
+      sparkle();
+    }
+    else if (neo_mode == twinkle_mode || neo_mode == fire_mode || neo_mode == meteor_mode)
+    {
+      particleEffect(neo_mode);
+    }
+    else if (neo_mode == audio_mode)
+    {
+      audioEffect();
     }
   }
 }
 
-unsigned long getDelay(unsigned long currentDelay) {
-  switch (last_speed)
-  {
-  case 1:
-    return currentDelay * 3;
-  case 2:
-    return currentDelay * 2;
-  case 4:
-    return currentDelay / 2;
-  case 5:
-    return currentDelay / 3;
-  default:
-    return currentDelay;
+// advance the phase by elapsed time x rate and step the effect once for every
+// frame it covers, so the cycle period only depends on the rate, never on how
+// often we're called. only the last of those steps is shown. a step renders the
+// whole frame, so a call takes at most NEO_MAX_STEPS_PER_LOOP and leaves the rest
+// owed to the next, and a backlog it can't work off is dropped, or every slow
+// call would make the next one slower still.
+void renderTimedFrames(uint8_t neo_mode) {
+  unsigned long now = neoNow();
+  unsigned long elapsed = min(now - last_phase_millis, (unsigned long)NEO_MAX_ELAPSED_MS);
+  last_phase_millis = now;
+  neo_phase += elapsed * neo_rate;
+
+  if (neo_restart) {
+    renderFrame(neo_mode); // the first frame of a new mode goes out straight away
+    neo_steps++;
+    neo_phase = 0;
   }
-}
 
-bool delayIsActive(uint8_t neoMode) {
-  if (in_delay)
-  {
-    unsigned long currentMillis = millis();
-    // delay is up, or mode is changed, so clear the delay either way
-    unsigned long currentModeDelay = neo_mode_delay;
-
-    // scale the delay so that the breath cycle is roughly the same duration regardless of the brightness
-    if (neoMode == breath_mode) {
-      int divisor = ((last_a - minBreathBrightness) / BREATH_SPEED);
-      divisor = max(1, divisor); // ensure we don't have a 0 divisor
-      currentModeDelay = neo_mode_delay / divisor;
-    }
+  unsigned long cost = getFrameCost();
+  unsigned long owed = neo_phase / cost;
 
-    unsigned long speedAdjustedDelay = getDelay(currentModeDelay);
+  if (!owed) {
+    return;
+  }
 
-    if ((currentMillis - last_delay_millis > speedAdjustedDelay) || (last_neo_mode != neoMode))
-    {
-      in_delay = false;
-    }
+  if (owed > NEO_MAX_OWED_STEPS) {
+    neo_dropped_steps += owed - NEO_MAX_OWED_STEPS;
+    neo_phase -= (owed - NEO_MAX_OWED_STEPS) * cost;
+    owed = NEO_MAX_OWED_STEPS;
   }
 
-  return in_delay;
-}
+  owed = min(owed, (unsigned long)NEO_MAX_STEPS_PER_LOOP);
+  neo_phase -= owed * cost;
+  neo_steps += owed;
 
-void beginDelay() {
-  last_delay_millis = millis();
-  in_delay = true;
-}
+  neo_catching_up = true;
+  while (--owed) {
+    renderFrame(neo_mode);
+  }
+  neo_catching_up = false;
 
-// get last mode or solid (if last was off)
-int getLastNeoMode() {
-  return last_neo_mode == off_mode ? solid_mode : last_neo_mode;
+  renderFrame(neo_mode);
 }
 
-void neoLoop(uint8_t r, uint8_t g, uint8_t b, uint8_t a, uint8_t neo_mode, uint8_t neo_speed) {
-  bool neoModeChanged = (neo_mode != last_neo_mode);
+void neoLoop() {
+  uint8_t neo_mode = current_neo_mode;
 
   if (neo_mode == off_mode) {
-    if (_neo_off) {
-      return;
-    }
-    strip.clear();
-    strip.show();
-    _neo_off = true;
     return;
-  } else if (_neo_off) {
-    _neo_off = false;
-    neoModeChanged = true;
   }
 
-  bool brightnessChanged = handleBrightnessChange(a, neo_mode); // set brightness if it has changed (if not breath mode)
-  bool colorChanged = handleColorChange(r, g, b); // update stored strip color if it has changed
-  handleResetNeoStep(neo_mode); // reset the defaults if the neo_mode changed, or set step to 0 if greater than neo_step_i_max
-
-  if (last_speed != neo_speed) {
-    Serial.print("Speed changed from ");
-    Serial.print(last_speed);
-    Serial.print(" to ");
-    Serial.println(neo_speed);
-
-    last_speed = neo_speed;
-  }
-  
-  // if currently delaying, keep delaying (unless mode changed)
-  if (delayIsActive(neo_mode)) {
-    return;
+  // sampling runs at its own rate, independent of the frame rate
+  if (neo_mode == audio_mode) {
+    audioSample();
   }
 
   if (neo_mode == solid_mode)
   {
     // only update if the mode, color, or brightness has changed 
-    if (colorChanged || brightnessChanged || neoModeChanged) {
-      strip.fill(stripColor);
-      strip.show();
+    if (neo_redraw || neo_restart) {
+      neoFill(stripColor);
+      neoShow();
     } 
   }
-  else if (neo_mode == breath_mode)
-  {
-    breathe();
-  }
-  else if (neo_mode == marquee_mode)
-  {
-    marquee();
-  }
-  else if (neo_mode == rainbow_marquee_mode)
+  else if (neo_mode == pattern_mode)
   {
-    rainbowMarquee();
+    patternLoop(neo_restart);
   }
-  else if (neo_mode == rainbow_mode)
+  else if (neo_mode == segments_mode)
   {
-    rainbow();
+    segmentsLoop(neo_restart, neo_redraw);
   }
-  else if (neo_mode == theater_mode)
+  else if (neoIsEffect(neo_mode))
   {
-    theater();
+    renderTimedFrames(neo_mode);
   }
-  else if (neo_mode == rainbow_theater_mode)
-  {
-    rainbowTheater();
+
+  neo_restart = false;
+  neo_redraw = false;
+}
+
+// nothing will change on the strip until the next state change
+bool neoIsIdle() {
+  if (neo_restart || neo_redraw) {
+    return false;
   }
 
-  updateValues(r, g, b, a, neo_mode); // store changed values and increment neo_step_i
+  return current_neo_mode == off_mode || current_neo_mode == solid_mode;
 }
 
 void breathe() {
@@ -296,9 +553,9 @@ void breathe() {
 
   newBrightness += minBreathBrightness; // pad for min of minBreathBrightness
   strip.setBrightness(newBrightness);
-  strip.fill(stripColor);
-  strip.show();
-  beginDelay();
+  neoFill(stripColor);
+  neoShow();
+  endFrame();
 
   neo_step_i++;
 
@@ -319,13 +576,13 @@ void marquee() {
   }
 
   if (neo_step_i * 2 >= neo_step_i_max) {
-    strip.setPixelColor(neo_step_i % (neo_step_i_max / 2), strip.Color(0,0,0));
+    neoSetPixel(neo_step_i % (neo_step_i_max / 2), strip.Color(0,0,0));
   } else {
-    strip.setPixelColor(neo_step_i, stripColor);  //  Set pixel's color (in RAM)
+    neoSetPixel(neo_step_i, stripColor);  //  Set pixel's color (in RAM)
   }
 
-  strip.show();                          //  Update strip to match
-  beginDelay();                           //  Pause for a moment
+  neoShow();                          //  Update strip to match
+  endFrame();                         //  Pause for a moment
   neo_step_i++;
 
   if (neo_step_i >= neo_step_i_max) {
@@ -340,8 +597,8 @@ void theater() {
   if (neo_step_k >= neo_step_k_max) { // increment j, reset k to new j, clear strip
     neo_step_j++;
     neo_step_k = neo_step_j;
-    strip.show();
-    beginDelay();
+    neoShow();
+    endFrame();
     strip.clear(); // clear on increment j
   }
 
@@ -357,7 +614,7 @@ void theater() {
     neo_step_k = 0;
   }
 
-  strip.setPixelColor(neo_step_k, stripColor);
+  neoSetPixel(neo_step_k, stripColor);
   neo_step_k += 3;
 }
 
@@ -369,10 +626,10 @@ void rainbow() {
   int pixelHue = neo_step_i + 65536L;
 
   uint32_t color = strip.gamma32(strip.ColorHSV(pixelHue));
-  strip.fill(color);
+  neoFill(color);
   neo_step_i += 256;
-  strip.show();
-  beginDelay();
+  neoShow();
+  endFrame();
 }
 
 // Rainbow cycle along whole strip.
@@ -384,8 +641,8 @@ void rainbowMarquee() {
   if (neo_step_j >= neo_step_j_max) { // increment i and reset j
     neo_step_i += 256;
     neo_step_j = 0;
-    strip.show(); // Update strip with new contents after each full loop of neo_step_j
-    beginDelay();  // Pause for a moment
+    neoShow(); // Update strip with new contents after each full loop of neo_step_j
+    endFrame();  // Pause for a moment
   }
 
   if (neo_step_i >= neo_step_i_max) { // reset everything
@@ -404,7 +661,7 @@ void rainbowMarquee() {
   // is passed through strip.gamma32() to provide 'truer' colors
   // before assigning to each pixel:
   int pixelNum = numStripPixels - neo_step_j;
-  strip.setPixelColor(pixelNum, strip.gamma32(strip.ColorHSV(pixelHue)));
+  neoSetPixel(pixelNum, strip.gamma32(strip.ColorHSV(pixelHue)));
   neo_step_j++;
 }
 
@@ -414,8 +671,8 @@ void rainbowTheater() {
   if (neo_step_k >= neo_step_k_max) { // increment j, reset k to new j, clear strip
     neo_step_j++;
     neo_step_k = neo_step_j;
-    strip.show();
-    beginDelay();
+    neoShow();
+    endFrame();
     firstPixelHue += 65536 / 90; // One cycle of color wheel over 90 frames
     // putting this here is equivalent to placing it at the beginning of the first nested for loop
     strip.clear(); // clear on increment j
@@ -438,31 +695,65 @@ void rainbowTheater() {
 
   int hue   = firstPixelHue + neo_step_k * 65536L / numStripPixels;
   uint32_t color = strip.gamma32(strip.ColorHSV(hue)); // hue -> RGB
-  strip.setPixelColor(neo_step_k, color);
+  neoSetPixel(neo_step_k, color);
   neo_step_k += 3;
 }
 
+// Light a single random pixel a random color each frame.
+void sparkle() {
+  strip.clear();
+  neoSetPixel(rngRange(numStripPixels), Wheel(rngByte()));
+  neoShow();
+  endFrame();
+}
+
+// Step the particle engine one frame for the current effect.
+void particleEffect(uint8_t neo_mode) {
+  if (neo_mode == twinkle_mode) {
+    particlesTwinkle();
+  } else if (neo_mode == fire_mode) {
+    particlesFire();
+  } else {
+    particlesMeteor();
+  }
+
+  neoShow();
+  endFrame();
+}
+
+// Light the strip from low to high frequency bands picked up by the microphone on A0,
+// each band its own color.
+void audioEffect() {
+  for (uint16_t i = 0; i < numStripPixels; i++) {
+    uint8_t band = (uint32_t)i * AUDIO_NUM_BANDS / numStripPixels;
+    neoSetPixel(i, strip.gamma32(strip.ColorHSV(band * (65536L / AUDIO_NUM_BANDS), 255, audioBandLevel(band))));
+  }
+
+  neoShow();
+  endFrame();
+}
+
 void solidOrange() {
   strip.setBrightness(75);
-  strip.fill(strip.Color(240, 100, 0));
-  strip.show();
+  neoFill(strip.Color(240, 100, 0));
+  neoShow();
 }
 
 void solidBlue() {
-  strip.fill(strip.Color(0, 100, 255));
+  neoFill(strip.Color(0, 100, 255));
   strip.setBrightness(75);
-  strip.show();
+  neoShow();
 }
 
 void solidRed() {
-  strip.fill(strip.Color(255, 0, 0));
+  neoFill(strip.Color(255, 0, 0));
   strip.setBrightness(75);
-  strip.show();
+  neoShow();
 }
 
 void clearStrip() {
   strip.clear();
-  strip.show();
+  neoShow();
 }
 
 uint8_t wheel_r (byte WheelPos) {
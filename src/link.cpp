@@ -0,0 +1,331 @@
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include <ESP8266WiFi.h>
+#include <LittleFS.h>
+
+#include "helpers.h"
+#include "link.h"
+
+// where we last connected, kept in rtc memory and mirrored to flash for power loss
+struct LinkCache {
+  uint32_t magic;
+  uint8_t bssid[6];
+  uint8_t channel;
+  uint8_t unused;
+  uint32_t ip;
+  uint32_t gateway;
+  uint32_t subnet;
+  uint32_t dns;
+  uint32_t check;
+};
+
+LinkCache link_cache;
+bool link_have_cache = false;
+
+// static ip settings, an ip of 0 means dhcp
+uint32_t link_static_ip = 0;
+uint32_t link_static_gateway = 0;
+uint32_t link_static_subnet = 0;
+uint32_t link_static_dns = 0;
+
+uint8_t link_state = link_down;
+unsigned long link_state_start = 0;
+unsigned long link_down_start = 0; // boot, or when we last lost the connection
+bool link_pinned = false; // the sdk will only join the cached bssid
+
+unsigned long link_boot_connect_ms = 0;
+unsigned long link_last_connect_ms = 0;
+bool link_last_fast = false;
+uint32_t link_reconnects = 0;
+
+uint32_t cacheCheck(const LinkCache* cache) {
+  const uint8_t* bytes = (const uint8_t*)cache;
+  uint32_t hash = 2166136261UL; // FNV-1a
+
+  for (size_t i = 0; i < offsetof(LinkCache, check); i++) {
+    hash = (hash ^ bytes[i]) * 16777619UL;
+  }
+
+  return hash;
+}
+
+bool cacheIsValid(const LinkCache* cache) {
+  return cache->magic == LINK_CACHE_MAGIC && cache->channel && cache->check == cacheCheck(cache);
+}
+
+String ipToString(uint32_t ip) {
+  return IPAddress(ip).toString();
+}
+
+uint32_t ipFromString(const char* ip) {
+  IPAddress address;
+  return address.fromString(ip) ? (uint32_t)address : 0;
+}
+
+void loadLinkConfig() {
+  File f = LittleFS.open(LINK_CONFIG_FILE, "r");
+
+  if (!f) {
+    return;
+  }
+
+  StaticJsonDocument<512> config;
+  DeserializationError error = deserializeJson(config, f);
+  f.close();
+
+  if (error) {
+    Serial.println(F("[ERROR] Could not read WiFi config"));
+    return;
+  }
+
+  link_static_ip = ipFromString(config["static"]["ip"] | "");
+  link_static_gateway = ipFromString(config["static"]["gateway"] | "");
+  link_static_subnet = ipFromString(config["static"]["subnet"] | "");
+  link_static_dns = ipFromString(config["static"]["dns"] | "");
+
+  // rtc memory is gone after a power loss, so fall back to the copy in flash
+  if (link_have_cache) {
+    return;
+  }
+
+  LinkCache cache = {};
+  JsonObject cached = config["cache"];
+
+  if (hexToBytes(cached["bssid"] | "", cache.bssid, sizeof(cache.bssid)) != sizeof(cache.bssid)) {
+    return;
+  }
+
+  cache.magic = LINK_CACHE_MAGIC;
+  cache.channel = cached["channel"] | 0;
+  cache.ip = ipFromString(cached["ip"] | "");
+  cache.gateway = ipFromString(cached["gateway"] | "");
+  cache.subnet = ipFromString(cached["subnet"] | "");
+  cache.dns = ipFromString(cached["dns"] | "");
+  cache.check = cacheCheck(&cache);
+
+  if (cacheIsValid(&cache)) {
+    link_cache = cache;
+    link_have_cache = true;
+  }
+}
+
+void saveLinkConfig() {
+  File f = LittleFS.open(LINK_CONFIG_FILE, "w");
+
+  if (!f) {
+    Serial.println(F("[ERROR] Could not save WiFi config"));
+    return;
+  }
+
+  StaticJsonDocument<512> config;
+
+  if (link_static_ip) {
+    JsonObject staticIp = config.createNestedObject("static");
+    staticIp["ip"] = ipToString(link_static_ip);
+    staticIp["gateway"] = ipToString(link_static_gateway);
+    staticIp["subnet"] = ipToString(link_static_subnet);
+    staticIp["dns"] = ipToString(link_static_dns);
+  }
+
+  if (link_have_cache) {
+    JsonObject cached = config.createNestedObject("cache");
+    cached["bssid"] = bytesToHex(link_cache.bssid, sizeof(link_cache.bssid));
+    cached["channel"] = link_cache.channel;
+    cached["ip"] = ipToString(link_cache.ip);
+    cached["gateway"] = ipToString(link_cache.gateway);
+    cached["subnet"] = ipToString(link_cache.subnet);
+    cached["dns"] = ipToString(link_cache.dns);
+  }
+
+  serializeJson(config, f);
+  f.close();
+}
+
+// remember where we just connected, flash is only written when that changes
+void saveCache() {
+  LinkCache cache = {};
+  cache.magic = LINK_CACHE_MAGIC;
+  memcpy(cache.bssid, WiFi.BSSID(), sizeof(cache.bssid));
+  cache.channel = WiFi.channel();
+  cache.ip = WiFi.localIP();
+  cache.gateway = WiFi.gatewayIP();
+  cache.subnet = WiFi.subnetMask();
+  cache.dns = WiFi.dnsIP();
+  cache.check = cacheCheck(&cache);
+
+  bool changed = !link_have_cache || memcmp(&cache, &link_cache, sizeof(cache));
+  link_cache = cache;
+  link_have_cache = true;
+  ESP.rtcUserMemoryWrite(LINK_RTC_OFFSET, (uint32_t*)&link_cache, sizeof(link_cache));
+
+  if (changed) {
+    saveLinkConfig();
+  }
+}
+
+void applyStatic() {
+  if (link_static_ip) {
+    WiFi.config(IPAddress(link_static_ip), IPAddress(link_static_gateway), IPAddress(link_static_subnet), IPAddress(link_static_dns));
+  } else {
+    WiFi.config(IPAddress(0, 0, 0, 0), IPAddress(0, 0, 0, 0), IPAddress(0, 0, 0, 0)); // back to dhcp
+  }
+}
+
+// join with the saved credentials, only the cached access point if bssid is set
+void beginJoin(int32_t channel, const uint8_t* bssid) {
+  String ssid = WiFi.SSID();
+  String psk = WiFi.psk();
+
+  WiFi.persistent(false); // don't wear the flash out saving the pinned bssid
+  WiFi.begin(ssid.c_str(), psk.c_str(), channel, bssid);
+  WiFi.persistent(true);
+  link_pinned = bssid != NULL;
+}
+
+void enterState(uint8_t next) {
+  unsigned long now = millis();
+
+  if (next == link_fast_join) {
+    Serial.println(F("[INFO] Joining the last access point"));
+    beginJoin(link_cache.channel, link_cache.bssid);
+  } else if (next == link_scan_join && link_pinned) {
+    Serial.println(F("[INFO] Scanning for any access point"));
+    beginJoin(0, NULL);
+  } else if (next == link_up) {
+    link_last_connect_ms = now - link_down_start;
+    link_last_fast = link_state == link_fast_join;
+
+    if (link_boot_connect_ms) {
+      link_reconnects++;
+    } else {
+      link_boot_connect_ms = now;
+    }
+
+    Serial.print(F("[INFO] Connected in "));
+    Serial.print(link_last_connect_ms);
+    Serial.println(link_last_fast ? F("ms, fast join") : F("ms"));
+
+    saveCache();
+  } else if (next == link_down) {
+    link_down_start = now;
+  }
+
+  link_state = next;
+  link_state_start = now;
+}
+
+void linkStep() {
+  uint8_t next = linkNextState(link_state, WiFi.status() == WL_CONNECTED, link_have_cache, millis() - link_state_start);
+
+  if (next != link_state) {
+    enterState(next);
+  }
+}
+
+void linkSetup() {
+  link_have_cache = ESP.rtcUserMemoryRead(LINK_RTC_OFFSET, (uint32_t*)&link_cache, sizeof(link_cache)) && cacheIsValid(&link_cache);
+
+  if (LittleFS.begin()) {
+    loadLinkConfig();
+  }
+
+  applyStatic();
+}
+
+// try the cached access point before app.begin() falls back to a full scan or the portal
+bool linkFastConnect() {
+  if (!link_have_cache || !WiFi.SSID().length()) {
+    return false;
+  }
+
+  while (link_state != link_up && link_state != link_scan_join) {
+    linkStep();
+    delay(10);
+  }
+
+  return link_state == link_up;
+}
+
+void linkLoop() {
+  linkStep();
+}
+
+// an empty ip goes back to dhcp, "lease" keeps the address we last got from dhcp
+bool linkConfigureStatic(String ip, String gateway, String subnet, String dns, bool persist) {
+  if (!ip.length()) {
+    link_static_ip = link_static_gateway = link_static_subnet = link_static_dns = 0;
+  } else if (ip == "lease") {
+    if (!link_have_cache || !link_cache.ip) {
+      return false;
+    }
+
+    link_static_ip = link_cache.ip;
+    link_static_gateway = link_cache.gateway;
+    link_static_subnet = link_cache.subnet;
+    link_static_dns = link_cache.dns;
+  } else {
+    uint32_t newIp = ipFromString(ip.c_str());
+    uint32_t newGateway = ipFromString(gateway.c_str());
+    uint32_t newSubnet = ipFromString(subnet.c_str());
+    uint32_t newDns = dns.length() ? ipFromString(dns.c_str()) : newGateway;
+
+    if (!newIp || !newGateway || !newSubnet || !newDns) {
+      return false;
+    }
+
+    link_static_ip = newIp;
+    link_static_gateway = newGateway;
+    link_static_subnet = newSubnet;
+    link_static_dns = newDns;
+  }
+
+  applyStatic(); // takes effect on the next connect
+
+  if (persist) {
+    saveLinkConfig();
+  }
+
+  return true;
+}
+
+String linkGetConfigAsJson() {
+  StaticJsonDocument<512> config;
+  config["dhcp"] = !link_static_ip;
+
+  if (link_static_ip) {
+    config["ip"] = ipToString(link_static_ip);
+    config["gateway"] = ipToString(link_static_gateway);
+    config["subnet"] = ipToString(link_static_subnet);
+    config["dns"] = ipToString(link_static_dns);
+  }
+
+  if (link_have_cache) {
+    JsonObject cached = config.createNestedObject("last");
+    cached["bssid"] = bytesToHex(link_cache.bssid, sizeof(link_cache.bssid));
+    cached["channel"] = link_cache.channel;
+    cached["ip"] = ipToString(link_cache.ip);
+  }
+
+  String output;
+  serializeJson(config, output);
+
+  return output;
+}
+
+// ms from boot until we first connected
+unsigned long linkBootConnectMs() {
+  return link_boot_connect_ms;
+}
+
+// ms the last connect took, from boot or from losing the connection
+unsigned long linkLastConnectMs() {
+  return link_last_connect_ms;
+}
+
+bool linkLastJoinWasFast() {
+  return link_last_fast;
+}
+
+uint32_t linkReconnectCount() {
+  return link_reconnects;
+}
@@ -0,0 +1,24 @@
+#include <Arduino.h>
+
+#include "link.h"
+
+// kept apart from link.cpp so it builds without the wifi stack
+uint8_t linkNextState(uint8_t state, bool connected, bool haveCache, unsigned long inStateMs) {
+  if (state == link_up) {
+    return connected ? link_up : link_down;
+  }
+
+  if (connected) {
+    return link_up;
+  }
+
+  if (state == link_down) {
+    return haveCache ? link_fast_join : link_scan_join;
+  }
+
+  if (state == link_fast_join && inStateMs >= LINK_FAST_JOIN_MS) {
+    return link_scan_join;
+  }
+
+  return state;
+}
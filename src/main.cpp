@@ -1,14 +1,26 @@
 #include <Arduino.h>
 #include <ArduinoJson.h>
-#include <EasierButton.h>   // https://github.com/RobretMcReed/EasierButton.git
 #include <ESP8266AutoIOT.h>   // https://github.com/RobretMcReed/ESP8266AutoIOT.git
 
-#include "html.h"
+#include "audio.h"
+#include "button.h"
+#include "events.h"
+#include "group.h"
+#include "history.h"
 #include "light.h"
+#include "link.h"
+#include "mqtt.h"
+#include "pattern.h"
+#include "power.h"
+#include "segments.h"
+#include "server.h"
+#include "websocket.h"
 #include "helpers.h"
+#include "rng.h"
+#include "scheduler.h"
+#include "trace.h"
 #include "defaults.h"
 
-EasierButton btn(D0, false);
 ESP8266AutoIOT app((char*)"esp8266", (char*)"newcouch");
 
 // utility
@@ -16,46 +28,83 @@ void handleReboot() {
   _resetFlagged = true;
   solidOrange();
   Serial.println(F("[INFO] Reboot pending in 5 seconds!"));
+  schedulerAfter(5000, []() { ESP.reset(); });
 }
 
 void handleResetAllSettings() {
   app.resetAllSettings(true);
 }
 
+// escape hatch - only reset if nobody clicked since the warning
+void handleHardReset() {
+  if (!_hardResetPending) {
+    return;
+  }
+
+  USE_WIFI = true; // this looks wrong
+  // but is actually needed so the network task calls app.loop()
+  // which is required for resetting the board
+  handleResetAllSettings(); // trigger the board to reboot
+}
+
+void cancelHardReset() {
+  _hardResetPending = false;
+  Serial.println(F("[INFO] Hard Reset aborted."));
+  stateChanges = change_all; // replace the red warning with the current state
+}
+
+// get last mode or solid (if we were never on)
+int getLastNeoMode() {
+  return lastOnMode;
+}
+
 int getModeNumFromModeName(String requestedMode) {
   if (!strcmp(requestedMode.c_str(), "off")) {
     return off_mode;
   }
 
+  if (!strcmp(requestedMode.c_str(), "pattern")) {
+    return pattern_mode;
+  }
+
+  if (!strcmp(requestedMode.c_str(), "segments")) {
+    return segments_mode;
+  }
+
   // return last mode registered if turned back "on"
   if (!strcmp(requestedMode.c_str(), "on")) {
     return getLastNeoMode();
   }
 
-  for (int i = 0; i < MODE_END; i++) {
-    if (!strcmp(requestedMode.c_str(), NEO_MODE_NAMES[i])) {
-      return i;
+  for (uint8_t i = 0; i < neoEffectCount(); i++) {
+    if (!strcmp_P(requestedMode.c_str(), effectName(i))) {
+      return neoEffectAt(i);
     }
   }
 
   return -1;
 }
 
+bool isRainbowMode(int mode) {
+  return neoEffectIndex(mode) > neoEffectIndex(theater_mode);
+}
+
 void ensureStatusMatchesMode(bool colorsChanged) {
   // set status unknown if device is off or colors changed while free/busy/dnd
   // or we just switched out of party mode
-  if ((neo_mode == off_mode) || (colorsChanged && (currentStatus < status_unknown)) || ((neo_mode < rainbow_mode) && (currentStatus == status_party))) {
+  if ((neo_mode == off_mode) || (colorsChanged && (currentStatus < status_unknown)) || (!isRainbowMode(neo_mode) && (currentStatus == status_party))) {
     currentStatus = status_unknown;
     // set party if any rainbow and not custom status
-  } else if ((neo_mode > theater_mode) && (currentStatus != status_custom)) {
+  } else if (isRainbowMode(neo_mode) && (currentStatus != status_custom)) {
     // set status to party if in rainbow mode, as long as no custom status is set
     currentStatus = status_party;
   }
 }
 
 bool setMode(int requestedMode) {
-  if (((requestedMode < MODE_END) && (requestedMode >= 0)) || requestedMode == off_mode) {
+  if ((requestedMode >= 0 && neoIsEffect(requestedMode)) || requestedMode == off_mode || requestedMode == pattern_mode || requestedMode == segments_mode) {
     neo_mode = requestedMode;
+    stateChanges |= change_mode;
     return true;
   }
 
@@ -80,23 +129,52 @@ void enforceColorMode() {
   if (neo_mode > theater_mode) {
     neo_mode = solid_mode;
   }
+
+  stateChanges |= change_brightness | change_mode;
 }
 
 // getters
 String getStatusAsString() {
-  String status = currentStatus == status_custom ? customStatus : STATUSES[currentStatus];
+  String status = currentStatus == status_custom ? String(customStatus) : String(FPSTR(statusName(currentStatus)));
   
   return status;
 }
 
+const __FlashStringHelper* getModeName(uint8_t mode) {
+  if (mode == pattern_mode) {
+    return F("pattern");
+  }
+
+  if (mode == segments_mode) {
+    return F("segments");
+  }
+
+  int8_t effect = neoEffectIndex(mode);
+
+  return effect >= 0 ? FPSTR(effectName(effect)) : F("off");
+}
+
+// the effect after the current one, or the first if we're not on an effect
 int getNextMode() {
-  uint8_t nextMode = neo_mode + 1;
+  int8_t effect = neoEffectIndex(neo_mode);
+
+  return neoEffectAt((effect + 1) % neoEffectCount());
+}
 
-  if (nextMode >= MODE_END) {
-    nextMode = 0;
+// cheap fingerprint of everything in getConfigAsJson(), so we only serialize when it changes
+uint32_t getStateVersion() {
+  uint8_t state[] = { r, g, b, a, neo_mode, speed, (uint8_t)(rate >> 8), (uint8_t)rate, currentStatus };
+  uint32_t hash = 2166136261UL; // FNV-1a
+
+  for (uint8_t i = 0; i < sizeof(state); i++) {
+    hash = (hash ^ state[i]) * 16777619UL;
+  }
+
+  for (const char* c = customStatus; currentStatus == status_custom && *c; c++) {
+    hash = (hash ^ *c) * 16777619UL;
   }
 
-  return nextMode;
+  return hash;
 }
 
 // getters - route handlers
@@ -105,7 +183,7 @@ String getStatusAsJson() {
 }
 
 String getConfigAsJson() {
-  const size_t capacity = JSON_ARRAY_SIZE(6) + JSON_OBJECT_SIZE(4);
+  const size_t capacity = JSON_ARRAY_SIZE(4) + JSON_OBJECT_SIZE(7) + NEO_MODE_NAME_SIZE; // the mode name is copied from flash
   DynamicJsonDocument neoDoc(capacity);
   
   String status = getStatusAsString();
@@ -115,9 +193,10 @@ String getConfigAsJson() {
   color.add(b);
   color.add(a);
   neoDoc["mode_num"] = neo_mode;
-  neoDoc["mode"] = (neo_mode < MODE_END) ? NEO_MODE_NAMES[neo_mode] : "off";
+  neoDoc["mode"] = getModeName(neo_mode);
   neoDoc["brightness"] = a;
   neoDoc["speed"] = speed;
+  neoDoc["rate"] = (rate ? rate : neoRateForSpeed(speed)) / (float)NEO_RATE_ONE;
   neoDoc["status"] = status.c_str();
   char output[256];
 
@@ -128,16 +207,17 @@ String getConfigAsJson() {
 
 // setters
 void setNextLightStyle() {
-  Serial.println("Next light style");
+  Serial.println(F("Next light style"));
   int nextMode = getNextMode();
-  if (neo_mode <= theater_mode && nextMode > theater_mode) {
-      nextMode = solid_mode;
-  } else if (neo_mode > theater_mode && neo_mode < MODE_END && nextMode < rainbow_mode) {
+  if (!isRainbowMode(neo_mode) && isRainbowMode(nextMode)) {
+    nextMode = solid_mode;
+  } else if (isRainbowMode(neo_mode) && !isRainbowMode(nextMode)) {
     nextMode = rainbow_mode;
   }
 
   neo_mode = nextMode;
   a = max(a, (uint8_t)15);
+  stateChanges |= change_brightness | change_mode;
 }
 
 void setFree() {
@@ -145,6 +225,7 @@ void setFree() {
   g = 255;
   b = 0;
   currentStatus = status_free;
+  stateChanges |= change_color;
 
   enforceColorMode();
 }
@@ -154,6 +235,7 @@ void setBusy() {
   g = 0;
   b = 255;
   currentStatus = status_busy;
+  stateChanges |= change_color;
 
   enforceColorMode();
 }
@@ -163,6 +245,7 @@ void setDND() {
   g = 0;
   b = 0;
   currentStatus = status_dnd;
+  stateChanges |= change_color;
 
   enforceColorMode();
 }
@@ -172,15 +255,17 @@ void setUnknown() {
 }
 
 void setParty() {
-  Serial.println("Set party");
+  Serial.println(F("Set party"));
   currentStatus = status_party;
   a = max(a, MED_A);
   neo_mode = rainbow_marquee_mode;
   speed = max((uint8_t)3, speed);
+  rate = 0;
+  stateChanges |= change_brightness | change_mode | change_speed;
 }
 
 void setNextStatus() {
-  Serial.println("Next status");
+  Serial.println(F("Next status"));
   if (currentStatus == status_free) {
     setBusy();
   } else if (currentStatus == status_busy) {
@@ -195,57 +280,79 @@ void setNextMode() {
 }
 
 void setOffMode() {
-  Serial.println("Setting off");
+  Serial.println(F("Setting off"));
   setModeSafe(off_mode);
 }
 
 void setRandomColor() {
-  Serial.println("Random color");
+  Serial.println(F("Random color"));
   enforceColorMode();
 
-  byte num = rand() % 255;
-
-  // ensure the color is different enough
-  while (
-    abs(num - _lastRand) < 40 
-      || (num < 20 && _lastRand > 235)
-      || (_lastRand < 20 && num > 235)
-  ) {
-    num = rand() % 255;
-  }
+  // walk at least 40 steps around the wheel in either direction, so the color is always different enough
+  byte num = _lastRand + 40 + rngRange(256 - 2 * 40 + 1);
 
   _lastRand = num;
   r = wheel_r(num & 255);
   g = wheel_g(num & 255);
   b = wheel_b(num & 255);
+  stateChanges |= change_color;
 }
 
 void setSpeedLow() {
   speed = 1;
+  rate = 0;
+  stateChanges |= change_speed;
 }
 
 void setSpeedMed() {
   speed = 3;
+  rate = 0;
+  stateChanges |= change_speed;
 }
 
 void setSpeedHigh() {
   speed = 5;
+  rate = 0;
+  stateChanges |= change_speed;
 }
 
 void setNextSpeed() {
-  Serial.println("Next speed");
+  Serial.println(F("Next speed"));
   if (++speed > 5) {
     speed = 1;
   }
+
+  rate = 0;
+  stateChanges |= change_speed;
 }
 
 void setBrightness(uint8_t newA) {
   a = min(newA, MAX_A);
-  a = max(newA, MIN);
+  a = max(a, MIN);
 
   if (neo_mode == off_mode) {
     neo_mode = getLastNeoMode();
   }
+
+  stateChanges |= change_brightness | change_mode;
+}
+
+void setColor(uint8_t newR, uint8_t newG, uint8_t newB) {
+  r = newR;
+  g = newG;
+  b = newB;
+
+  if (neo_mode == off_mode) {
+    // if we're off go back to last mode unless last mode was party, then go to solid
+    uint8_t last_mode = getLastNeoMode();
+    neo_mode = last_mode < rainbow_mode ? last_mode : solid_mode;
+  } else if (neo_mode > theater_mode) {
+    // if we aren't in a color mode revert to solid
+    neo_mode = solid_mode;
+  }
+
+  stateChanges |= change_color | change_mode;
+  ensureStatusMatchesMode(true);
 }
 
 void setBrightnessLow() {
@@ -261,7 +368,7 @@ void setBrightnessHigh() {
 }
 
 void setNextBrightness() {
-  Serial.println("Next brightness");
+  Serial.println(F("Next brightness"));
   if (a < LOW_A) {
     setBrightnessLow();
   } else if (a < MED_A) {
@@ -278,6 +385,22 @@ String setModeSafeAndGetJson(int newMode) {
   return getConfigAsJson();
 }
 
+void applyLiveUpdate(LiveUpdate update) {
+  if (update.hasColor) {
+    setColor(update.r, update.g, update.b);
+  }
+
+  if (update.hasBrightness) {
+    setBrightness(update.a);
+  }
+
+  if (update.hasSpeed) {
+    speed = max(min(update.speed, MAX_SPEED), MIN_SPEED);
+    rate = 0;
+    stateChanges |= change_speed;
+  }
+}
+
 // setters - route handlers
 String handleGetHostnameRequest() {
   String hostname = app.getHostname();
@@ -285,7 +408,7 @@ String handleGetHostnameRequest() {
 }
 
 String handleSetConfigRequest(String body) {
-  Serial.print("[REQUEST]: ");
+  Serial.print(F("[REQUEST]: "));
   Serial.println(body);
 
   char json[body.length() + 1];
@@ -297,11 +420,15 @@ String handleSetConfigRequest(String body) {
     return errorMessage;
   }
 
-  if (!(jsonBody.containsKey("mode") || jsonBody.containsKey("mode_num") || jsonBody.containsKey("color") || jsonBody.containsKey("brightness") || jsonBody.containsKey("speed") || jsonBody.containsKey("status"))) {
-    String errorMessage = makeErrorJson("mode, mode_num, brightness, color, speed, or status is required.");
+  if (!(jsonBody.containsKey("mode") || jsonBody.containsKey("mode_num") || jsonBody.containsKey("color") || jsonBody.containsKey("brightness") || jsonBody.containsKey("speed") || jsonBody.containsKey("rate") || jsonBody.containsKey("status") || jsonBody.containsKey("seed"))) {
+    String errorMessage = makeErrorJson("mode, mode_num, brightness, color, speed, rate, status, or seed is required.");
     return errorMessage;
   }
 
+  if (jsonBody.containsKey("seed")) {
+    rngSeed(jsonBody["seed"]); // replay the same random colors and effects
+  }
+
   bool success = true;
   if (jsonBody.containsKey("mode")) {
     String requestedMode = jsonBody["mode"];
@@ -319,6 +446,8 @@ String handleSetConfigRequest(String body) {
       // if we're off but sent a color, go back to last mode unless last mode was party, then go to solid
       neo_mode = last_mode < rainbow_mode ? last_mode : solid_mode;
     }
+
+    stateChanges |= change_mode;
   }
 
   if (!success) {
@@ -334,7 +463,7 @@ String handleSetConfigRequest(String body) {
     r = jsonBody["color"][0];
     g = jsonBody["color"][1];
     b = jsonBody["color"][2];
-    temp_a = jsonBody["color"][3];
+    temp_a = jsonBody["color"][3] | a; // keep the current brightness if only rgb was sent
 
     r = max(r, MIN);
     r = min(r, MAX);
@@ -349,6 +478,8 @@ String handleSetConfigRequest(String body) {
       // if we aren't in a color mode revert to solid
       neo_mode = solid_mode;
     }
+
+    stateChanges |= change_color | change_mode;
   }
 
   if (jsonBody.containsKey("brightness")) {
@@ -358,12 +489,23 @@ String handleSetConfigRequest(String body) {
   if (temp_a >= MIN) {
     a = max(temp_a, MIN);
     a = min(temp_a, MAX_A);
+    stateChanges |= change_brightness;
   }
 
   if (jsonBody.containsKey("speed")) {
     speed = jsonBody["speed"];
     speed = min(speed, MAX_SPEED);
     speed = max(speed, MIN_SPEED);
+    rate = 0;
+    stateChanges |= change_speed;
+  }
+
+  // a continuous multiplier on the animation speed, 0.1 to 10 times normal
+  if (jsonBody.containsKey("rate")) {
+    float newRate = jsonBody["rate"];
+    newRate = constrain(newRate, NEO_RATE_MIN / (float)NEO_RATE_ONE, NEO_RATE_MAX / (float)NEO_RATE_ONE);
+    rate = newRate * NEO_RATE_ONE;
+    stateChanges |= change_rate;
   }
 
   bool skipEnsureStatus = false;
@@ -371,24 +513,24 @@ String handleSetConfigRequest(String body) {
     String status = jsonBody["status"];
 
     // { "Free", "Busy", "Do Not Disturb", "Unknown", "Party!" };
-    if (!strcmp(status.c_str(), STATUSES[0])) {
+    if (!strcmp_P(status.c_str(), statusName(0))) {
       setFree();
-    } else if (!strcmp(status.c_str(), STATUSES[1])) {
+    } else if (!strcmp_P(status.c_str(), statusName(1))) {
       setBusy();
-    } else if (!strcmp(status.c_str(), STATUSES[2])) {
+    } else if (!strcmp_P(status.c_str(), statusName(2))) {
       setDND();
-    } else if (!strcmp(status.c_str(), STATUSES[3])) {
+    } else if (!strcmp_P(status.c_str(), statusName(3))) {
       skipEnsureStatus = true;
       setUnknown();
-    } else if (!strcmp(status.c_str(), STATUSES[4])) {
+    } else if (!strcmp_P(status.c_str(), statusName(4))) {
       setParty();
     } else {
       skipEnsureStatus = true;
       currentStatus = status_custom;
-      strcpy(customStatus, status.c_str());
+      strlcpy(customStatus, status.c_str(), sizeof(customStatus)); // longer statuses are cut short
     }
 
-    Serial.print("Setting status to: ");
+    Serial.print(F("Setting status to: "));
     Serial.println(getStatusAsString());
   }
 
@@ -398,12 +540,314 @@ String handleSetConfigRequest(String body) {
   }
 
   String neoSettings = getConfigAsJson();
-  Serial.print("[RESPONSE]: ");
+  Serial.print(F("[RESPONSE]: "));
   Serial.println(neoSettings);
 
   return neoSettings;
 }
 
+String handleGetPatternRequest() {
+  return makeSimpleJson("pattern", bytesToHex(patternCode(), patternLength()));
+}
+
+String handleSetPatternRequest(String body) {
+  Serial.print(F("[REQUEST]: "));
+  Serial.println(body);
+
+  DeserializationError jsonError = deserializeJson(jsonBody, body);
+
+  if (jsonError) {
+    return makeErrorJson(jsonError.c_str());
+  }
+
+  if (!jsonBody.containsKey("pattern")) {
+    return makeErrorJson("pattern is required.");
+  }
+
+  uint8_t code[PATTERN_MAX_BYTES];
+  int len = hexToBytes(jsonBody["pattern"].as<String>(), code, PATTERN_MAX_BYTES);
+
+  if (len <= 0 || !patternLoad(code, len, true)) {
+    return makeErrorJson("Invalid pattern");
+  }
+
+  return setModeSafeAndGetJson(pattern_mode);
+}
+
+String getSegmentsAsJson() {
+  const size_t capacity = JSON_OBJECT_SIZE(1) + JSON_ARRAY_SIZE(MAX_SEGMENTS) + MAX_SEGMENTS * (JSON_OBJECT_SIZE(5) + JSON_ARRAY_SIZE(3) + NEO_MODE_NAME_SIZE);
+  DynamicJsonDocument segDoc(capacity);
+  JsonArray segments = segDoc.createNestedArray("segments");
+
+  for (uint8_t i = 0; i < segmentsCount(); i++) {
+    uint16_t first, count;
+    uint8_t rgb[3], mode, segSpeed;
+    segmentsGet(i, &first, &count, rgb, &mode, &segSpeed);
+
+    JsonObject segment = segments.createNestedObject();
+    segment["start"] = first;
+    segment["count"] = count;
+    JsonArray color = segment.createNestedArray("color");
+    color.add(rgb[0]);
+    color.add(rgb[1]);
+    color.add(rgb[2]);
+    segment["mode"] = getModeName(mode);
+    segment["speed"] = segSpeed;
+  }
+
+  String output;
+  serializeJson(segDoc, output);
+
+  return output;
+}
+
+String handleSetSegmentsRequest(String body) {
+  Serial.print(F("[REQUEST]: "));
+  Serial.println(body);
+
+  DeserializationError jsonError = deserializeJson(jsonBody, body);
+
+  if (jsonError) {
+    return makeErrorJson(jsonError.c_str());
+  }
+
+  if (!jsonBody.containsKey("segments")) {
+    return makeErrorJson("segments is required.");
+  }
+
+  segmentsClear();
+
+  for (JsonObject segment : jsonBody["segments"].as<JsonArray>()) {
+    int mode = getModeNumFromModeName(segment["mode"] | "solid");
+    uint8_t segSpeed = segment["speed"] | speed;
+
+    bool success = segmentsAdd(
+      segment["start"] | 0,
+      segment["count"] | 0,
+      segment["color"][0] | r,
+      segment["color"][1] | g,
+      segment["color"][2] | b,
+      mode,
+      max(min(segSpeed, MAX_SPEED), MIN_SPEED)
+    );
+
+    if (mode < 0 || !success) {
+      segmentsClear();
+      return makeErrorJson("Invalid segment. Segments need a start, a count within the strip, and a light mode.");
+    }
+  }
+
+  setModeSafe(segments_mode);
+
+  return getSegmentsAsJson();
+}
+
+String handleGetMqttRequest() {
+  return mqttGetConfigAsJson();
+}
+
+String handleSetMqttRequest(String body) {
+  DeserializationError jsonError = deserializeJson(jsonBody, body);
+
+  if (jsonError) {
+    return makeErrorJson(jsonError.c_str());
+  }
+
+  if (!jsonBody.containsKey("host")) {
+    return makeErrorJson("host is required.");
+  }
+
+  bool success = mqttConfigure(
+    jsonBody["host"].as<String>(),
+    jsonBody["port"] | 1883,
+    jsonBody["user"] | "",
+    jsonBody["password"] | "",
+    jsonBody["topic"] | "",
+    true
+  );
+
+  if (!success) {
+    return makeErrorJson("host, user, password or topic is too long.");
+  }
+
+  return mqttGetConfigAsJson();
+}
+
+String getFrameAsJson() {
+  const size_t capacity = JSON_OBJECT_SIZE(6);
+  DynamicJsonDocument frameDoc(capacity);
+  String frame = bytesToHex(neoPixels(), neoPixelBytes());
+
+  frameDoc["pixels"] = neoPixelBytes() / neoBytesPerPixel();
+  frameDoc["bytes_per_pixel"] = neoBytesPerPixel();
+  frameDoc["brightness"] = strip.getBrightness();
+  frameDoc["limit_scale"] = neoLimitScale();
+  frameDoc["frames"] = neoFrameCount();
+  frameDoc["frame"] = frame.c_str();
+
+  String output;
+  serializeJson(frameDoc, output);
+
+  return output;
+}
+
+String handleSetTraceRequest(String body) {
+  DeserializationError jsonError = deserializeJson(jsonBody, body);
+
+  if (jsonError) {
+    return makeErrorJson(jsonError.c_str());
+  }
+
+  if (!jsonBody.containsKey("recording")) {
+    return makeErrorJson("recording is required.");
+  }
+
+  if (jsonBody["recording"]) {
+    // reseed and restart the animation, so the seed and the state changes that
+    // follow are all a replay needs to render the same frames
+    uint32_t seed = rngNext();
+    rngSeed(seed);
+    traceStart(seed);
+    stateChanges |= change_all;
+  } else {
+    traceStop();
+  }
+
+  return traceGetAsJson();
+}
+
+String handleReplayRequest(String body) {
+  DeserializationError jsonError = deserializeJson(jsonBody, body);
+
+  if (jsonError) {
+    return makeErrorJson(jsonError.c_str());
+  }
+
+  int mode = getModeNumFromModeName(jsonBody["mode"] | "");
+
+  if (mode < 0 || !neoIsEffect(mode)) {
+    return makeErrorJson("mode must be an effect.");
+  }
+
+  // the recorder and a replay both need the frame hook
+  if (traceIsRecording()) {
+    return makeErrorJson("Stop the trace first.");
+  }
+
+  uint32_t color = ((uint32_t)(jsonBody["color"][0] | MAX) << 16) | ((uint32_t)(jsonBody["color"][1] | MAX) << 8) | (jsonBody["color"][2] | MAX);
+  uint8_t brightness = constrain(jsonBody["brightness"] | NEO_BRIGHTNESS_MAX, 0, NEO_BRIGHTNESS_MAX);
+  uint16_t neoRate = jsonBody.containsKey("rate")
+    ? (uint16_t)(constrain(jsonBody["rate"].as<float>(), NEO_RATE_MIN / (float)NEO_RATE_ONE, NEO_RATE_MAX / (float)NEO_RATE_ONE) * NEO_RATE_ONE)
+    : neoRateForSpeed(jsonBody["speed"] | 3);
+
+  String replay = traceReplay(mode, color, brightness, neoRate, jsonBody["seed"] | 1UL, jsonBody["ms"] | 5000UL, jsonBody["step"] | 20UL);
+
+  // put back whatever was showing, from the start
+  stateChanges |= change_all;
+
+  return replay;
+}
+
+String handleGetWiFiRequest() {
+  return linkGetConfigAsJson();
+}
+
+String handleSetWiFiRequest(String body) {
+  DeserializationError jsonError = deserializeJson(jsonBody, body);
+
+  if (jsonError) {
+    return makeErrorJson(jsonError.c_str());
+  }
+
+  bool success = linkConfigureStatic(
+    jsonBody["ip"] | "",
+    jsonBody["gateway"] | "",
+    jsonBody["subnet"] | "",
+    jsonBody["dns"] | "",
+    true
+  );
+
+  if (!success) {
+    return makeErrorJson("ip, gateway and subnet must be valid addresses, or ip must be \"lease\" after connecting once.");
+  }
+
+  return linkGetConfigAsJson();
+}
+
+String handleGetGroupRequest() {
+  return groupGetConfigAsJson();
+}
+
+String handleSetGroupRequest(String body) {
+  DeserializationError jsonError = deserializeJson(jsonBody, body);
+
+  if (jsonError) {
+    return makeErrorJson(jsonError.c_str());
+  }
+
+  if (!jsonBody.containsKey("groups")) {
+    return makeErrorJson("groups is required.");
+  }
+
+  uint32_t groups = 0;
+
+  for (uint8_t group : jsonBody["groups"].as<JsonArray>()) {
+    if (group < 1 || group > GROUP_MAX_GROUPS) {
+      return makeErrorJson("groups must be 1 to 32.");
+    }
+
+    groups |= 1UL << (group - 1);
+  }
+
+  bool success = groupConfigure(
+    jsonBody["address"] | GROUP_DEFAULT_ADDRESS,
+    jsonBody["port"] | GROUP_DEFAULT_PORT,
+    groups,
+    true
+  );
+
+  if (!success) {
+    return makeErrorJson("address must be a multicast address.");
+  }
+
+  return groupGetConfigAsJson();
+}
+
+String handleGetPresetsRequest() {
+  return groupGetPresetsAsJson();
+}
+
+String handleSetPresetRequest(String body) {
+  DeserializationError jsonError = deserializeJson(jsonBody, body);
+
+  if (jsonError) {
+    return makeErrorJson(jsonError.c_str());
+  }
+
+  int preset = jsonBody["preset"] | 0;
+
+  if (preset < 1 || preset > GROUP_MAX_PRESETS) {
+    return makeErrorJson("preset must be 1 to 8.");
+  }
+
+  // no config clears the preset
+  String config;
+
+  if (jsonBody.containsKey("config")) {
+    if (!jsonBody["config"].is<JsonObject>()) {
+      return makeErrorJson("config must be an object.");
+    }
+
+    serializeJson(jsonBody["config"], config);
+  }
+
+  if (!groupSavePreset(preset, config)) {
+    return makeErrorJson("Could not save preset.");
+  }
+
+  return groupGetPresetsAsJson();
+}
+
 // setters - route handlers - status setters
 String handleSetFreeRequest() {
   setFree();
@@ -478,18 +922,24 @@ String handleSetRainbowTheaterRequest() {
   return setModeSafeAndGetJson(rainbow_theater_mode);
 }
 
+String handleSetPatternModeRequest() {
+  return setModeSafeAndGetJson(pattern_mode);
+}
+
+String handleSetSegmentsModeRequest() {
+  return setModeSafeAndGetJson(segments_mode);
+}
+
 String handleSetNextMode() {
   return setModeSafeAndGetJson(getNextMode());
 }
 
 String handleSetPrevMode() {
-  int prevMode = neo_mode - 1; // specifically an int
+  int8_t effect = neoEffectIndex(neo_mode);
+  uint8_t count = neoEffectCount();
 
-  if ((prevMode >= MODE_END) || (prevMode < 0)) {
-    prevMode = MODE_END - 1;
-  }
-
-  return setModeSafeAndGetJson(prevMode);
+  // off, pattern and segments step back to the last effect
+  return setModeSafeAndGetJson(neoEffectAt(effect <= 0 ? count - 1 : effect - 1));
 }
 
 String handleSetSpeedLow() {
@@ -507,6 +957,58 @@ String handleSetSpeedHigh() {
   return getConfigAsJson();
 }
 
+// parse a path parameter as a whole number in [min, max], or -1
+long parseParam(String param, long minValue, long maxValue) {
+  if (!param.length() || param.length() > 4) {
+    return -1;
+  }
+
+  for (unsigned int i = 0; i < param.length(); i++) {
+    if (param[i] < '0' || param[i] > '9') {
+      return -1;
+    }
+  }
+
+  long value = param.toInt();
+
+  return (value < minValue || value > maxValue) ? -1 : value;
+}
+
+String handleSetSpeedParamRequest(String param) {
+  long newSpeed = parseParam(param, MIN_SPEED, MAX_SPEED);
+
+  if (newSpeed < 0) {
+    return makeErrorJson("Speed must be low, medium, high, or 1 to 5.");
+  }
+
+  speed = newSpeed;
+  rate = 0;
+  stateChanges |= change_speed;
+  return getConfigAsJson();
+}
+
+String handleSetBrightnessParamRequest(String param) {
+  long newA = parseParam(param, MIN, MAX_A);
+
+  if (newA < 0) {
+    return makeErrorJson("Brightness must be low, medium, high, or 0 to 150.");
+  }
+
+  setBrightness(newA);
+  return getConfigAsJson();
+}
+
+String handleSetColorRequest(String hex) {
+  uint8_t rgb[3];
+
+  if (hexToBytes(hex, rgb, 3) != 3) {
+    return makeErrorJson("Color must be 6 hex digits, as rrggbb.");
+  }
+
+  setColor(rgb[0], rgb[1], rgb[2]);
+  return getConfigAsJson();
+}
+
 String handleSetBrightnessLow() {
   setBrightnessLow();
 
@@ -518,144 +1020,390 @@ String handleSetBrightnessMed() {
   return getConfigAsJson();
 }
 
+String getMetricsAsJson() {
+  const size_t capacity = JSON_OBJECT_SIZE(20) + JSON_ARRAY_SIZE(SCHEDULER_MAX_TASKS) + SCHEDULER_MAX_TASKS * JSON_OBJECT_SIZE(5);
+  DynamicJsonDocument metricsDoc(capacity);
+
+  metricsDoc["idle"] = powerIsIdle();
+  metricsDoc["duty_cycle"] = powerDutyCycle();
+  metricsDoc["estimated_ma"] = powerEstimatedMilliamps();
+  metricsDoc["sleeps"] = powerSleepCount();
+  metricsDoc["frames"] = neoFrameCount();
+  metricsDoc["dropped_steps"] = neoDroppedStepCount();
+  metricsDoc["led_ma"] = neoEstimatedMilliamps();
+  metricsDoc["led_budget_ma"] = neoMilliampBudget();
+  metricsDoc["limited_frames"] = neoLimitedFrameCount();
+  metricsDoc["connect_ms"] = linkBootConnectMs();
+  metricsDoc["last_connect_ms"] = linkLastConnectMs();
+  metricsDoc["fast_join"] = linkLastJoinWasFast();
+  metricsDoc["reconnects"] = linkReconnectCount();
+  metricsDoc["free_heap"] = ESP.getFreeHeap();
+  metricsDoc["max_free_block"] = ESP.getMaxFreeBlockSize();
+  metricsDoc["heap_fragmentation"] = ESP.getHeapFragmentation();
+  metricsDoc["boot_heap"] = bootHeap;
+  metricsDoc["ready_heap"] = readyHeap;
+  metricsDoc["sketch_size"] = ESP.getSketchSize();
+  metricsDoc["free_sketch_space"] = ESP.getFreeSketchSpace(); // OTA needs room for a second copy
+  JsonArray tasks = metricsDoc.createNestedArray("tasks");
+
+  for (uint8_t i = 0; i < schedulerTaskCount(); i++) {
+    const char* name;
+    uint32_t runs, misses, overruns, maxUs;
+    schedulerGetTask(i, &name, &runs, &misses, &overruns, &maxUs);
+
+    JsonObject task = tasks.createNestedObject();
+    task["name"] = name;
+    task["runs"] = runs;
+    task["misses"] = misses;
+    task["overruns"] = overruns;
+    task["max_us"] = maxUs;
+  }
+
+  String output;
+  serializeJson(metricsDoc, output);
+
+  return output;
+}
+
 String handleSetBrightnessHigh() {
   setBrightnessHigh();
   return getConfigAsJson();
 }
 
-// WiFi Event Handlers
+// WiFi Event Handlers - only queue the event, the state machine acts on it
 
 void handleDisconnected() {
-  solidOrange();
-  wiFiStatus = disconnected;
-  _r = 240;
-  _g = 100;
-  _b = 0;
+  eventsPush(event_wifi_lost);
 }
 
 void handleInConfig() {
-  solidBlue();
-  wiFiStatus = inConfig;
-  _r = 0;
-  _g = 100;
-  _b = 255;
+  eventsPush(event_wifi_config);
 }
 
 void handleConnected() {
-  wiFiStatus = connected;
-  clearStrip();
+  eventsPush(event_wifi_connected);
+}
+
+// breathe the connection state over whatever the user set, until we reconnect
+void showLinkState(uint8_t linkR, uint8_t linkG, uint8_t linkB) {
+  neoSetColor(linkR, linkG, linkB);
+  neoSetBrightness(100);
+  neoSetSpeed(3);
+  neoSetMode(breath_mode);
+}
+
+// the status/mode state machine, every button and WiFi input goes through here in order.
+// network commands call the same setters from taskNetwork(), see include/events.h
+void handleEvent(uint8_t event) {
+  switch (event)
+  {
+  case event_click:
+    if (_hardResetPending) {
+      cancelHardReset();
+    } else {
+      setNextStatus();
+    }
+    break;
+  case event_double_click:
+    setNextLightStyle();
+    break;
+  case event_triple_click:
+    setNextBrightness();
+    break;
+  case event_long_click:
+    setNextSpeed();
+    break;
+  case event_hold_color:
+    setRandomColor();
+    break;
+  case event_hold_party:
+    setParty();
+    break;
+  case event_hold_off:
+    setOffMode();
+    break;
+  case event_hold_reboot:
+    handleReboot();
+    break;
+  case event_wifi_lost:
+    wiFiStatus = disconnected;
+    showLinkState(240, 100, 0);
+    break;
+  case event_wifi_config:
+    wiFiStatus = inConfig;
+    showLinkState(0, 100, 255);
+    break;
+  case event_wifi_connected:
+    wiFiStatus = connected;
+    groupRejoin();
+    stateChanges = change_all; // put back everything the link state covered up
+    break;
+  }
+}
+
+bool handleEvents() {
+  uint8_t event;
+  bool handled = false;
+
+  while (eventsPop(&event)) {
+    handleEvent(event);
+    handled = true;
+  }
+
+  return handled;
+}
+
+// tell the renderer only what changed, and nothing while the link state is showing
+bool publishState() {
+  if (!stateChanges || (USE_WIFI && wiFiStatus != connected)) {
+    return false;
+  }
+
+  if (stateChanges & change_color) {
+    neoSetColor(r, g, b);
+    traceState(trace_color, ((uint32_t)r << 16) | ((uint32_t)g << 8) | b);
+  }
+
+  if (stateChanges & change_brightness) {
+    neoSetBrightness(a);
+    traceState(trace_brightness, a);
+  }
+
+  if (stateChanges & (change_speed | change_rate)) {
+    uint16_t neoRate = rate ? rate : neoRateForSpeed(speed);
+    neoSetRate(neoRate);
+    traceState(trace_rate, neoRate);
+  }
+
+  if (stateChanges & change_mode) {
+    neoSetMode(neo_mode);
+    traceState(trace_mode, neo_mode);
+    lastOnMode = neo_mode == off_mode ? lastOnMode : neo_mode;
+  }
+
+  stateChanges = 0;
+  return true;
 }
 
 // setup helpers
 
 void setupButton() {
-  btn.setOnSingleClick(setNextStatus);
-  btn.setOnDoubleClick(setNextLightStyle);
-  btn.setOnTripleClick(setNextBrightness);
+  buttonOnClicks(1, []() { eventsPush(event_click); });
+  buttonOnClicks(2, []() { eventsPush(event_double_click); });
+  buttonOnClicks(3, []() { eventsPush(event_triple_click); });
 
-  btn.setOnReleasedAfter(500, setNextSpeed);
-  btn.setOnHold(1250, setRandomColor);
-  btn.setOnHold(2500, setParty);
+  buttonOnReleasedAfter(500, []() { eventsPush(event_long_click); });
+  buttonOnHold(1250, []() { eventsPush(event_hold_color); });
+  buttonOnHold(2500, []() { eventsPush(event_hold_party); });
 
-  btn.setOnHold(3500, setOffMode);
-  btn.setOnHold(10000, handleReboot);
+  buttonOnHold(3500, []() { eventsPush(event_hold_off); });
+  buttonOnHold(10000, []() { eventsPush(event_hold_reboot); });
 }
 
-void setupApp() {
-  // setup our app
-  solidBlue(); // blue until we connect to WiFi
-  app.enableCors();
-  app.disableLED();
-  app.root(HTML);
-
+// every route the device answers, looked up by hash in O(path length)
+const Route ROUTES[] = {
   // return the current hostname
-  app.get("/hostname", handleGetHostnameRequest);
+  ROUTE_GET("/hostname", handleGetHostnameRequest),
 
   // power
-  app.get("/power/on", handleSetOnRequest); // turn lights on (revert to previously known state)
-  app.get("/power/off", handleSetOffRequest); // turn lights off
-  app.get("/power/toggle", handleToggleRequest); // turn lights off or revert to previous state
+  ROUTE_GET("/power/on", handleSetOnRequest), // turn lights on (revert to previously known state)
+  ROUTE_GET("/power/off", handleSetOffRequest), // turn lights off
+  ROUTE_GET("/power/toggle", handleToggleRequest), // turn lights off or revert to previous state
 
   // status
-  app.get("/status", getStatusAsJson); // get current status
-  app.get("/status/free", handleSetFreeRequest); // mark self as free (green)
-  app.get("/status/busy", handleSetBusyRequest); // mark self as busy (yellow)
-  app.get("/status/dnd", handleSetDNDRequest); // mark self as dnd (red)
-  app.get("/status/party", handleSetPartyRequest); // mark self as Party!
-  app.get("/status/unknown", handleSetUnknownRequest); // mark self as unknown (status only)
+  ROUTE_GET("/status", getStatusAsJson), // get current status
+  ROUTE_GET("/status/free", handleSetFreeRequest), // mark self as free (green)
+  ROUTE_GET("/status/busy", handleSetBusyRequest), // mark self as busy (yellow)
+  ROUTE_GET("/status/dnd", handleSetDNDRequest), // mark self as dnd (red)
+  ROUTE_GET("/status/party", handleSetPartyRequest), // mark self as Party!
+  ROUTE_GET("/status/unknown", handleSetUnknownRequest), // mark self as unknown (status only)
+  ROUTE_GET("/status/history", historyGetAsJson), // time spent in each status, per day and in total
+
+  // power and timing metrics
+  ROUTE_GET("/metrics", getMetricsAsJson),
+
+  // remote debugging
+  ROUTE_GET("/frame", getFrameAsJson), // the pixels as last sent to the strip, in hex
+  ROUTE_GET("/trace", traceGetAsJson), // the flight recorder's state changes and frame timings
+  ROUTE_POST("/trace", handleSetTraceRequest), // start or stop the flight recorder
+  ROUTE_POST("/trace/replay", handleReplayRequest), // render a mode on a fake clock and log its frames
 
   // config
-  app.post("/config", handleSetConfigRequest); // set any setting manually
-  app.get("/config/state", getConfigAsJson); // get full config
+  ROUTE_POST("/config", handleSetConfigRequest), // set any setting manually
+  ROUTE_GET("/config/state", getConfigAsJson), // get full config
 
   // config shorthand - mode
-  app.get("/config/mode/next", handleSetNextMode); // change to next mode
-  app.get("/config/mode/prev", handleSetPrevMode); // change to next mode
-  app.get("/config/mode/solid", handleSetSolidRequest); // change to solid mode
-  app.get("/config/mode/breath", handleSetBreathRequest); // change to breath mode
-  app.get("/config/mode/marquee", handleSetMarqueeRequest); // change to marquee mode
-  app.get("/config/mode/theater", handleSetTheaterRequest); // change to theater mode
-  app.get("/config/mode/rainbow", handleSetRainbowRequest); // change to rainbow mode
-  app.get("/config/mode/rainbow/marquee", handleSetRainbowMarqueeRequest); // change to rainbow marquee mode
-  app.get("/config/mode/marquee/rainbow", handleSetRainbowMarqueeRequest); // change to rainbow marquee mode
-  app.get("/config/mode/rainbow/theater", handleSetRainbowTheaterRequest); // change to theater rainbow mode
-  app.get("/config/mode/theater/rainbow", handleSetRainbowTheaterRequest); // change to theater rainbow mode
+  ROUTE_GET("/config/mode/next", handleSetNextMode), // change to next mode
+  ROUTE_GET("/config/mode/prev", handleSetPrevMode), // change to next mode
+  ROUTE_GET("/config/mode/solid", handleSetSolidRequest), // change to solid mode
+  ROUTE_GET("/config/mode/breath", handleSetBreathRequest), // change to breath mode
+  ROUTE_GET("/config/mode/marquee", handleSetMarqueeRequest), // change to marquee mode
+  ROUTE_GET("/config/mode/theater", handleSetTheaterRequest), // change to theater mode
+  ROUTE_GET("/config/mode/rainbow", handleSetRainbowRequest), // change to rainbow mode
+  ROUTE_GET_ALIAS("/config/mode/rainbow/marquee", "/config/mode/marquee/rainbow", handleSetRainbowMarqueeRequest), // change to rainbow marquee mode
+  ROUTE_GET_ALIAS("/config/mode/rainbow/theater", "/config/mode/theater/rainbow", handleSetRainbowTheaterRequest), // change to theater rainbow mode
+  ROUTE_GET("/config/mode/pattern", handleSetPatternModeRequest), // play the uploaded pattern
+  ROUTE_GET("/config/mode/segments", handleSetSegmentsModeRequest), // show the configured segments
+
+  // user defined patterns
+  ROUTE_GET("/pattern", handleGetPatternRequest), // get the uploaded pattern as hex
+  ROUTE_POST("/pattern", handleSetPatternRequest), // upload, save and play a pattern
+
+  // strip segments
+  ROUTE_GET("/segments", getSegmentsAsJson), // get the configured segments
+  ROUTE_POST("/segments", handleSetSegmentsRequest), // replace all segments and show them
+
+  // mqtt
+  ROUTE_GET("/mqtt", handleGetMqttRequest), // get the broker settings
+  ROUTE_POST("/mqtt", handleSetMqttRequest), // set and save the broker settings
+
+  // wifi
+  ROUTE_GET("/wifi", handleGetWiFiRequest), // get the static ip settings and the last access point
+  ROUTE_POST("/wifi", handleSetWiFiRequest), // set and save a static ip, or go back to dhcp
+
+  // group control
+  ROUTE_GET("/group", handleGetGroupRequest), // get the multicast groups we listen to
+  ROUTE_POST("/group", handleSetGroupRequest), // set and save the multicast groups
+  ROUTE_GET("/group/presets", handleGetPresetsRequest), // get the saved presets
+  ROUTE_POST("/group/presets", handleSetPresetRequest), // save or clear a preset
 
   // config shorthand - speed
-  app.get("/config/speed/low", handleSetSpeedLow);
-  app.get("/config/speed/medium", handleSetSpeedMed);
-  app.get("/config/speed/med", handleSetSpeedMed);
-  app.get("/config/speed/high", handleSetSpeedHigh);
+  ROUTE_GET("/config/speed/low", handleSetSpeedLow),
+  ROUTE_GET_ALIAS("/config/speed/medium", "/config/speed/med", handleSetSpeedMed),
+  ROUTE_GET("/config/speed/high", handleSetSpeedHigh),
+  ROUTE_GET_PARAM("/config/speed/*", handleSetSpeedParamRequest), // set speed [1, 5]
 
   // config shorthand - brightness
-  app.get("/config/brightness/low", handleSetBrightnessLow);
-  app.get("/config/brightness/medium", handleSetBrightnessMed);
-  app.get("/config/brightness/med", handleSetBrightnessMed);
-  app.get("/config/brightness/high", handleSetBrightnessHigh);
-  
+  ROUTE_GET("/config/brightness/low", handleSetBrightnessLow),
+  ROUTE_GET_ALIAS("/config/brightness/medium", "/config/brightness/med", handleSetBrightnessMed),
+  ROUTE_GET("/config/brightness/high", handleSetBrightnessHigh),
+  ROUTE_GET_PARAM("/config/brightness/*", handleSetBrightnessParamRequest), // set brightness [0, 150]
+
+  // config shorthand - color
+  ROUTE_GET_PARAM("/config/color/*", handleSetColorRequest), // set color as rrggbb hex
+};
+
+void setupApp() {
+  // setup our app
+  solidBlue(); // blue until we connect to WiFi
+  app.disableLED();
+
   // setup event listeners
   app.setOnDisconnect(handleDisconnected);
   app.setOnEnterConfig(handleInConfig);
   app.setOnConnect(handleConnected);
 
+  // rejoin the last access point directly, app.begin() then only scans if that failed
+  linkSetup();
+  linkFastConnect();
+
   // enter the config portal and block until connected to WiFi
   app.begin();
   clearStrip();
+
+  // the portal and api are served by our own server so we control the headers
+  serverBegin(ROUTES, sizeof(ROUTES) / sizeof(Route));
+  websocketSetup(applyLiveUpdate, getConfigAsJson, getStateVersion);
+
+  mqttSetup(app.getHostname(), handleSetConfigRequest, getConfigAsJson, getStateVersion);
+  mqttSetEffects(NEO_MODE_NAMES, neoEffectCount());
+
+  groupSetup(handleSetConfigRequest, STATUSES, NUM_STATUSES);
+}
+
+// scheduled tasks
+
+void taskInput() {
+  if (_resetFlagged) {
+    return;
+  }
+
+  buttonUpdate(); // decode the edges the interrupt captured into gestures
+
+  // run the state machine over everything queued since the last frame
+  if (handleEvents() | publishState()) {
+    powerActivity();
+  }
+}
+
+void taskRender() {
+  if (_resetFlagged) {
+    return; // keep the reboot warning up
+  }
+
+  neoLoop();
+}
+
+void taskNetwork() {
+  if (!USE_WIFI || _resetFlagged) {
+    return;
+  }
+
+  if (!app.loop()) {
+    return; // this indicates a reboot is pending
+  }
+
+  linkLoop(); // rejoin the last access point first when the connection drops
+
+  if (wiFiStatus == connected) {
+    if (serverLoop()) { // apply this frame's api requests
+      powerActivity();
+    }
+
+    websocketLoop(); // apply the latest live update, push state to portals
+    mqttLoop(); // never blocks, connecting happens on the network stack
+
+    if (groupLoop()) { // apply commands sent to our groups
+      powerActivity();
+    }
+  }
+}
+
+void taskHousekeeping() {
+  historyLoop(currentStatus, customStatus); // log status changes
+  powerLoop(neoIsIdle() && !buttonIsPressed()); // light sleep while the frame is static
+}
+
+void setupTasks() {
+  schedulerAdd("input", taskInput, priority_input, 2000);
+  schedulerAdd("render", taskRender, priority_render, 10000);
+  schedulerAdd("network", taskNetwork, priority_network, 20000);
+  schedulerAdd("housekeeping", taskHousekeeping, priority_housekeeping, POWER_IDLE_SLEEP_MS * 1000UL + 1000);
 }
 
 // HERE WE GO!
 
 void setup() {
+  bootHeap = ESP.getFreeHeap(); // what static RAM left us, before anything is allocated
   Serial.begin(115200, SERIAL_8N1, SERIAL_TX_ONLY);
-  delay(1000);
+
+  rngSeedFromHardware(); // so every boot gets a different sequence
 
   neoSetup(); // initialize light strip
+  patternSetup(); // load the saved pattern, if any
+  historySetup(STATUSES, NUM_STATUSES); // load the saved status history
+  audioSetup(); // precompute the audio band filters
 
-  bool held = btn.begin(1000);
+  bool held = buttonBegin(1000);
 
   if (held) {
     USE_WIFI = false;
     Serial.println(F("[INFO] Button held at boot. Skipping WiFi!"));
     solidOrange(); // acknowledge no WiFi mode
+    stateChanges = 0; // hold the indicator until a timer lets the state through
 
-    if (btn.heldFor(4000)) {
+    if (buttonHeldFor(4000)) {
       Serial.println(F("[WARNING] __HARD_RESET__ in 5 seconds..."));
       solidRed(); // acknowledge the pending reboot
       Serial.println(F("[INFO] Click in the next 5 seconds to cancel"));
-      // escape hatch - click to cancel reboot
-      if (!btn.waitForClick(5000)) {
-        USE_WIFI = true; // this looks wrong
-        // but is actually needed so we call app.loop() below
-        // which is required for resetting the board
-        handleResetAllSettings(); // trigger the board to reboot
-        return;
-      } else {
-        Serial.println(F("[INFO] Hard Reset aborted."));
-      }
+      _hardResetPending = true;
+      schedulerAfter(5000, handleHardReset);
     } else {
       // keep orange light on for 2 seconds to show we're not in WiFi mode
-      delay(2000);
-      Serial.println(F("[INFO] Starting without WiFi!"));
+      schedulerAfter(2000, []() {
+        Serial.println(F("[INFO] Starting without WiFi!"));
+        stateChanges = change_all;
+      });
     }
   }
 
@@ -664,34 +1412,18 @@ void setup() {
   if (USE_WIFI) {
     setupApp(); // blocks loop until connected to WiFi
   }
-}
-
-void loop() {
-  if (_resetFlagged) {
-    delay(5000);
-    ESP.reset();
-    delay(5000);
-    return;
-  }
-  
-  bool loopOK = true;
 
-  if (USE_WIFI) {
-    if (!app.loop()) {
-      return; // this indicates a reboot is pending
-    }
+  powerSetup(USE_WIFI, buttonArmWakeup, buttonDisarmWakeup);
+  setupTasks();
 
-    loopOK = wiFiStatus == connected;
-  }
-
-  btn.update(); // update button state
+  readyHeap = ESP.getFreeHeap();
+  Serial.print(F("[INFO] Free heap "));
+  Serial.print(bootHeap);
+  Serial.print(F(" at boot, "));
+  Serial.print(readyHeap);
+  Serial.println(F(" once running"));
+}
 
-  if (loopOK)
-  {
-    neoLoop(r, g, b, a, neo_mode, speed); // still connected or not using WiFi
-  }
-  else
-  {
-    neoLoop(_r, _g, _b, 100, breath_mode, 3); // lost WiFi connection
-  }
+void loop() {
+  schedulerLoop();
 }
@@ -0,0 +1,321 @@
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include <ESP8266WiFi.h>
+#include <LittleFS.h>
+#include <AsyncMqttClient.h> // https://github.com/marvinroger/async-mqtt-client
+
+#include "mqtt.h"
+
+// dns, connecting and waiting on the broker all happen on the network stack,
+// so a dead or slow broker never holds up the loop
+AsyncMqttClient mqtt;
+
+char mqtt_host[64] = "";
+uint16_t mqtt_port = 1883;
+char mqtt_user[32] = "";
+char mqtt_pass[32] = "";
+char mqtt_topic[64] = "";
+char mqtt_will_topic[80] = ""; // the client keeps a pointer to this
+String mqtt_device_id;
+
+const char* const* mqtt_effects = NULL;
+uint8_t mqtt_num_effects = 0;
+
+MqttCommandHandler mqtt_on_command = NULL;
+MqttStateGetter mqtt_get_state = NULL;
+MqttVersionGetter mqtt_get_version = NULL;
+
+unsigned long mqtt_backoff = MQTT_MIN_BACKOFF;
+unsigned long last_mqtt_attempt = 0;
+bool mqtt_attempted = false;
+bool mqtt_connecting = false;
+bool mqtt_just_connected = false; // announce ourselves on the next loop
+
+// commands arrive on the network stack and are applied in mqttLoop(), in order
+String mqtt_pending[MQTT_MAX_PENDING];
+uint8_t mqtt_num_pending = 0;
+String mqtt_partial; // a message that arrives in pieces
+bool mqtt_publish_forced = true;
+uint32_t mqtt_published_version = 0;
+
+String mqttTopic(const char* suffix) {
+  String topic = mqtt_topic;
+  topic += "/";
+  topic += suffix;
+
+  return topic;
+}
+
+void handleMqttMessage(char* topic, char* payload, AsyncMqttClientMessageProperties properties, size_t len, size_t index, size_t total) {
+  if (total > MQTT_BUFFER_SIZE) {
+    return;
+  }
+
+  if (index == 0) {
+    mqtt_partial = "";
+  }
+
+  mqtt_partial.concat(payload, len);
+
+  if (index + len < total) {
+    return;
+  }
+
+  if (mqtt_num_pending >= MQTT_MAX_PENDING) {
+    Serial.println(F("[ERROR] MQTT commands arriving too fast, dropped one"));
+    return;
+  }
+
+  mqtt_pending[mqtt_num_pending++] = mqtt_partial;
+  mqtt_partial = "";
+}
+
+void handleMqttConnect(bool sessionPresent) {
+  mqtt_connecting = false;
+  mqtt_just_connected = true;
+}
+
+void handleMqttDisconnect(AsyncMqttClientDisconnectReason reason) {
+  if (mqtt_connecting) {
+    Serial.print(F("[ERROR] MQTT connect failed with reason "));
+    Serial.println((uint8_t)reason);
+    mqtt_backoff = min(mqtt_backoff * 2, (unsigned long)MQTT_MAX_BACKOFF);
+  }
+
+  mqtt_connecting = false;
+}
+
+void mqttSetEffects(const char* const* names, uint8_t count) {
+  mqtt_effects = names;
+  mqtt_num_effects = count;
+}
+
+// announce ourselves to Home Assistant as a light and a status sensor
+void publishDiscovery() {
+  String stateTopic = mqttTopic("state");
+  String availabilityTopic = mqttTopic("availability");
+  DynamicJsonDocument discovery(MQTT_BUFFER_SIZE);
+  String payload;
+
+  JsonObject device = discovery.createNestedObject("device");
+  device["identifiers"] = mqtt_device_id;
+  device["name"] = mqtt_device_id;
+  device["model"] = "ESP8266 Status Light";
+
+  discovery["name"] = mqtt_device_id;
+  discovery["unique_id"] = mqtt_device_id + "_light";
+  discovery["schema"] = "template";
+  discovery["state_topic"] = stateTopic;
+  discovery["command_topic"] = mqttTopic("set");
+  discovery["availability_topic"] = availabilityTopic;
+  discovery["command_on_template"] = "{\"mode\":\"{{ effect if effect is defined else 'on' }}\""
+    "{% if brightness is defined %},\"brightness\":{{ (brightness * 150 / 255) | int }}{% endif %}"
+    "{% if red is defined %},\"color\":[{{ red }},{{ green }},{{ blue }}]{% endif %}}";
+  discovery["command_off_template"] = "{\"mode\":\"off\"}";
+  discovery["state_template"] = "{{ 'off' if value_json.mode == 'off' else 'on' }}";
+  discovery["brightness_template"] = "{{ (value_json.brightness * 255 / 150) | int }}";
+  discovery["red_template"] = "{{ value_json.color[0] }}";
+  discovery["green_template"] = "{{ value_json.color[1] }}";
+  discovery["blue_template"] = "{{ value_json.color[2] }}";
+  discovery["effect_template"] = "{{ value_json.mode }}";
+
+  JsonArray effects = discovery.createNestedArray("effect_list");
+  for (uint8_t i = 0; i < mqtt_num_effects; i++) {
+    effects.add(FPSTR(pgm_read_ptr(&mqtt_effects[i])));
+  }
+
+  serializeJson(discovery, payload);
+  mqtt.publish(("homeassistant/light/" + mqtt_device_id + "/config").c_str(), 0, true, payload.c_str());
+
+  discovery.clear();
+  payload = "";
+
+  JsonObject sensorDevice = discovery.createNestedObject("device");
+  sensorDevice["identifiers"] = mqtt_device_id;
+  discovery["name"] = mqtt_device_id + " status";
+  discovery["unique_id"] = mqtt_device_id + "_status";
+  discovery["state_topic"] = stateTopic;
+  discovery["availability_topic"] = availabilityTopic;
+  discovery["value_template"] = "{{ value_json.status }}";
+
+  serializeJson(discovery, payload);
+  mqtt.publish(("homeassistant/sensor/" + mqtt_device_id + "_status/config").c_str(), 0, true, payload.c_str());
+}
+
+// runs on the loop once the broker has accepted us
+void announce() {
+  Serial.println(F("[INFO] Connected to MQTT broker"));
+
+  mqtt.publish(mqtt_will_topic, 1, true, "online");
+  mqtt.subscribe(mqttTopic("set").c_str(), 1);
+  publishDiscovery();
+  mqtt_publish_forced = true;
+  mqtt_backoff = MQTT_MIN_BACKOFF;
+}
+
+void loadMqttConfig() {
+  File f = LittleFS.open(MQTT_CONFIG_FILE, "r");
+
+  if (!f) {
+    return;
+  }
+
+  StaticJsonDocument<384> config;
+  DeserializationError error = deserializeJson(config, f);
+  f.close();
+
+  if (error) {
+    Serial.println(F("[ERROR] Could not read MQTT config"));
+    return;
+  }
+
+  mqttConfigure(config["host"] | "", config["port"] | 1883, config["user"] | "", config["password"] | "", config["topic"] | "", false);
+}
+
+void saveMqttConfig() {
+  File f = LittleFS.open(MQTT_CONFIG_FILE, "w");
+
+  if (!f) {
+    Serial.println(F("[ERROR] Could not save MQTT config"));
+    return;
+  }
+
+  StaticJsonDocument<384> config;
+  config["host"] = mqtt_host;
+  config["port"] = mqtt_port;
+  config["user"] = mqtt_user;
+  config["password"] = mqtt_pass;
+  config["topic"] = mqtt_topic;
+  serializeJson(config, f);
+  f.close();
+}
+
+void mqttSetup(String deviceId, MqttCommandHandler onCommand, MqttStateGetter getState, MqttVersionGetter getVersion) {
+  mqtt_device_id = deviceId;
+  mqtt_on_command = onCommand;
+  mqtt_get_state = getState;
+  mqtt_get_version = getVersion;
+
+  mqtt.setClientId(mqtt_device_id.c_str());
+  mqtt.onConnect(handleMqttConnect);
+  mqtt.onDisconnect(handleMqttDisconnect);
+  mqtt.onMessage(handleMqttMessage);
+
+  if (LittleFS.begin()) {
+    loadMqttConfig();
+  }
+}
+
+bool mqttConfigure(String host, uint16_t port, String user, String password, String topic, bool persist) {
+  if (host.length() >= sizeof(mqtt_host) || user.length() >= sizeof(mqtt_user) || password.length() >= sizeof(mqtt_pass) || topic.length() >= sizeof(mqtt_topic)) {
+    return false;
+  }
+
+  if (mqtt.connected() || mqtt_connecting) {
+    mqtt_connecting = false;
+    mqtt.disconnect(true);
+  }
+
+  strcpy(mqtt_host, host.c_str());
+  strcpy(mqtt_user, user.c_str());
+  strcpy(mqtt_pass, password.c_str());
+  mqtt_port = port ? port : 1883;
+
+  if (topic.length()) {
+    strcpy(mqtt_topic, topic.c_str());
+  } else {
+    snprintf(mqtt_topic, sizeof(mqtt_topic), "status_light/%s", mqtt_device_id.c_str());
+  }
+
+  snprintf(mqtt_will_topic, sizeof(mqtt_will_topic), "%s/availability", mqtt_topic);
+
+  // the client keeps pointers to these, so they're all in our own buffers
+  mqtt.setServer(mqtt_host, mqtt_port);
+  mqtt.setCredentials(mqtt_user[0] ? mqtt_user : NULL, mqtt_pass[0] ? mqtt_pass : NULL);
+  mqtt.setWill(mqtt_will_topic, 1, true, "offline");
+  mqtt_backoff = MQTT_MIN_BACKOFF;
+  mqtt_attempted = false; // try right away
+
+  if (persist) {
+    saveMqttConfig();
+  }
+
+  return true;
+}
+
+String mqttGetConfigAsJson() {
+  StaticJsonDocument<256> config;
+  config["host"] = mqtt_host;
+  config["port"] = mqtt_port;
+  config["user"] = mqtt_user;
+  config["topic"] = mqtt_topic;
+  config["connected"] = mqtt.connected();
+
+  String output;
+  serializeJson(config, output);
+
+  return output;
+}
+
+void mqttLoop() {
+  if (!mqtt_host[0] || WiFi.status() != WL_CONNECTED) {
+    return;
+  }
+
+  if (!mqtt.connected()) {
+    unsigned long now = millis();
+
+    if (mqtt_connecting) {
+      // the network stack would keep retrying a handshake for minutes
+      if (now - last_mqtt_attempt >= MQTT_CONNECT_TIMEOUT) {
+        Serial.println(F("[ERROR] MQTT connect timed out"));
+        mqtt_connecting = false;
+        mqtt_backoff = min(mqtt_backoff * 2, (unsigned long)MQTT_MAX_BACKOFF);
+        mqtt.disconnect(true);
+      }
+
+      return;
+    }
+
+    if (mqtt_attempted && now - last_mqtt_attempt < mqtt_backoff) {
+      return;
+    }
+
+    mqtt_attempted = true;
+    last_mqtt_attempt = now;
+    mqtt_connecting = true;
+
+    Serial.print(F("[INFO] Connecting to MQTT broker "));
+    Serial.println(mqtt_host);
+    mqtt.connect(); // returns right away, handleMqttConnect() or handleMqttDisconnect() follows
+
+    return;
+  }
+
+  if (mqtt_just_connected) {
+    mqtt_just_connected = false;
+    announce();
+  }
+
+  // the state is published below, as its version will have changed
+  for (uint8_t i = 0; i < mqtt_num_pending; i++) {
+    if (mqtt_on_command) {
+      mqtt_on_command(mqtt_pending[i]);
+    }
+
+    mqtt_pending[i] = "";
+  }
+
+  mqtt_num_pending = 0;
+
+  // only serialize and publish when something actually changed
+  uint32_t version = mqtt_get_version();
+  if (mqtt_publish_forced || version != mqtt_published_version) {
+    String state = mqtt_get_state();
+
+    if (mqtt.publish(mqttTopic("state").c_str(), 0, true, state.c_str())) {
+      mqtt_published_version = version;
+      mqtt_publish_forced = false;
+    }
+  }
+}
@@ -0,0 +1,158 @@
+#include <Arduino.h>
+#include <Adafruit_NeoPixel.h>
+#include "light.h"
+#include "particles.h"
+#include "rng.h"
+
+uint8_t FIRE_COOLING = 55; // larger number makes shorter flames
+uint8_t FIRE_SPARKING = 120; // chance out of 255 of a new spark each frame
+uint8_t METEOR_CHANCE = 12; // chance out of 255 of a new meteor each frame
+
+// everything is preallocated, so a frame never touches the heap
+Particle particles[PARTICLE_POOL_SIZE];
+uint8_t heat[PARTICLE_MAX_PIXELS];
+uint8_t heat_hue[PARTICLE_MAX_PIXELS];
+uint16_t num_pixels = 0;
+uint8_t max_cooling = 0;
+
+// Q8 helpers
+uint8_t qadd8(uint8_t a, uint8_t b) {
+  uint16_t sum = a + b;
+  return sum > 255 ? 255 : sum;
+}
+
+uint8_t qsub8(uint8_t a, uint8_t b) {
+  return a > b ? a - b : 0;
+}
+
+uint8_t qscale8(uint8_t value, uint8_t scale) {
+  return ((uint16_t)value * (1 + scale)) >> 8;
+}
+
+void particlesReset(uint16_t numPixels) {
+  num_pixels = min(numPixels, (uint16_t)PARTICLE_MAX_PIXELS);
+  max_cooling = min((FIRE_COOLING * 10) / max(num_pixels, (uint16_t)1) + 2, 255);
+  memset(particles, 0, sizeof(particles));
+  memset(heat, 0, sizeof(heat));
+  memset(heat_hue, 0, sizeof(heat_hue));
+}
+
+Particle* spawnParticle() {
+  for (uint8_t i = 0; i < PARTICLE_POOL_SIZE; i++) {
+    if (!particles[i].life) {
+      return &particles[i];
+    }
+  }
+
+  return NULL; // pool exhausted, skip this spawn
+}
+
+// Map a heat value to black -> red -> yellow -> white.
+uint32_t heatColor(uint8_t temperature) {
+  uint8_t t192 = qscale8(temperature, 191);
+  uint8_t ramp = (t192 & 0x3f) << 2;
+
+  if (t192 > 0x80) {
+    return strip.Color(255, 255, ramp);
+  } else if (t192 > 0x40) {
+    return strip.Color(255, ramp, 0);
+  }
+
+  return strip.Color(ramp, 0, 0);
+}
+
+// Flames rising from the start of the strip, after Fire2012 by Mark Kriegsman.
+void particlesFire() {
+  // cool every cell down a little
+  for (uint16_t i = 0; i < num_pixels; i++) {
+    heat[i] = qsub8(heat[i], rngRange(max_cooling));
+  }
+
+  // heat drifts up and diffuses a little
+  for (int k = num_pixels - 1; k >= 2; k--) {
+    heat[k] = ((uint16_t)heat[k - 1] + heat[k - 2] + heat[k - 2]) * 85 >> 8; // divide by 3
+  }
+
+  // randomly ignite new sparks near the bottom
+  if (rngByte() < FIRE_SPARKING) {
+    uint16_t y = rngRange(min(num_pixels, (uint16_t)3));
+    heat[y] = qadd8(heat[y], 160 + rngRange(96));
+  }
+
+  for (uint16_t i = 0; i < num_pixels; i++) {
+    neoSetPixel(i, heatColor(heat[i]));
+  }
+}
+
+// Pixels randomly light up a random color and slowly fade back out.
+void particlesTwinkle() {
+  // longer strips get proportionally more twinkles
+  uint8_t spawnChance = min(num_pixels * 6, 255);
+  if (rngByte() < spawnChance) {
+    Particle* p = spawnParticle();
+
+    if (p) {
+      p->pos = (int32_t)rngRange(num_pixels) << 8;
+      p->vel = 0;
+      p->hue = rngByte();
+      p->life = 255;
+    }
+  }
+
+  strip.clear();
+
+  for (uint8_t i = 0; i < PARTICLE_POOL_SIZE; i++) {
+    Particle* p = &particles[i];
+
+    if (!p->life) {
+      continue;
+    }
+
+    neoSetPixel(p->pos >> 8, strip.gamma32(strip.ColorHSV(p->hue << 8, 255, p->life)));
+    p->life = qsub8(p->life, (p->life >> 4) + 1);
+  }
+}
+
+// Meteors race along the strip leaving a sparkling, decaying trail.
+void particlesMeteor() {
+  if (rngByte() < METEOR_CHANCE) {
+    Particle* p = spawnParticle();
+
+    if (p) {
+      p->pos = 0;
+      p->vel = 64 + rngRange(192); // 0.25 - 1 pixels per frame
+      p->hue = rngByte();
+      p->life = 255;
+    }
+  }
+
+  // decay the trail, randomly so it sparkles
+  for (uint16_t i = 0; i < num_pixels; i++) {
+    if (rngByte() < 160) {
+      heat[i] = qscale8(heat[i], 200);
+    }
+  }
+
+  for (uint8_t i = 0; i < PARTICLE_POOL_SIZE; i++) {
+    Particle* p = &particles[i];
+
+    if (!p->life) {
+      continue;
+    }
+
+    p->pos += p->vel;
+
+    if ((p->pos >> 8) >= num_pixels) {
+      p->life = 0;
+      continue;
+    }
+
+    uint16_t pixel = p->pos >> 8;
+    heat[pixel] = 255;
+    heat_hue[pixel] = p->hue;
+  }
+
+  for (uint16_t i = 0; i < num_pixels; i++) {
+    neoSetPixel(i, heat[i] ? strip.gamma32(strip.ColorHSV(heat_hue[i] << 8, 255, heat[i])) : 0);
+  }
+}
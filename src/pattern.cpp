@@ -0,0 +1,251 @@
+#include <Arduino.h>
+#include <Adafruit_NeoPixel.h>
+#include <LittleFS.h>
+#include "light.h"
+#include "pattern.h"
+
+// operand bytes following each opcode, indexed by PATTERN_OPS
+const uint8_t PATTERN_OP_ARGS[OP_END] = { 0, 3, 5, 2, 1, 0, 2 };
+
+uint8_t pattern[PATTERN_MAX_BYTES];
+size_t pattern_len = 0;
+
+// interpreter state
+size_t pattern_pc = 0;
+uint8_t pattern_depth = 0;
+size_t loop_pc[PATTERN_MAX_LOOP_DEPTH];
+uint8_t loop_remaining[PATTERN_MAX_LOOP_DEPTH];
+uint16_t seg_start = 0;
+uint16_t seg_count = 0;
+uint8_t seg_r = 0;
+uint8_t seg_g = 0;
+uint8_t seg_b = 0;
+
+bool pattern_fading = false;
+uint8_t fade_from[3];
+uint8_t fade_to[3];
+bool pattern_holding = false;
+unsigned long pattern_wait_start = 0;
+unsigned long pattern_wait = 0;
+unsigned long last_pattern_frame = 0;
+
+uint16_t readDuration(size_t pc) {
+  return ((uint16_t)pattern[pc] << 8) | pattern[pc + 1];
+}
+
+// walk the bytecode once so the interpreter never has to bounds check
+bool patternIsValid(const uint8_t* code, size_t len) {
+  int depth = 0;
+  size_t pc = 0;
+
+  while (pc < len) {
+    uint8_t op = code[pc];
+
+    if (op >= OP_END || pc + PATTERN_OP_ARGS[op] >= len) {
+      return false;
+    }
+
+    if (op == op_loop && ++depth > PATTERN_MAX_LOOP_DEPTH) {
+      return false;
+    }
+
+    if (op == op_next && --depth < 0) {
+      return false;
+    }
+
+    if (op == op_segment && code[pc + 1] >= strip.numPixels()) {
+      return false;
+    }
+
+    pc += PATTERN_OP_ARGS[op] + 1;
+  }
+
+  return depth == 0;
+}
+
+void patternReset() {
+  pattern_pc = 0;
+  pattern_depth = 0;
+  pattern_fading = false;
+  pattern_holding = false;
+  seg_start = 0;
+  seg_count = strip.numPixels();
+  seg_r = seg_g = seg_b = 0;
+}
+
+void patternSetup() {
+  if (!LittleFS.begin()) {
+    Serial.println(F("[ERROR] Could not mount LittleFS, patterns will not persist"));
+    return;
+  }
+
+  File f = LittleFS.open(PATTERN_FILE, "r");
+
+  if (!f) {
+    return;
+  }
+
+  uint8_t code[PATTERN_MAX_BYTES];
+  size_t len = f.read(code, min(f.size(), (size_t)PATTERN_MAX_BYTES));
+  f.close();
+
+  if (patternLoad(code, len, false)) {
+    Serial.print(F("[INFO] Loaded pattern of "));
+    Serial.print(len);
+    Serial.println(F(" bytes"));
+  }
+}
+
+bool patternLoad(const uint8_t* code, size_t len, bool persist) {
+  if (len == 0 || len > PATTERN_MAX_BYTES || !patternIsValid(code, len)) {
+    return false;
+  }
+
+  memcpy(pattern, code, len);
+  pattern_len = len;
+  patternReset();
+
+  if (persist) {
+    File f = LittleFS.open(PATTERN_FILE, "w");
+
+    if (f) {
+      f.write(pattern, pattern_len);
+      f.close();
+    } else {
+      Serial.println(F("[ERROR] Could not save pattern"));
+    }
+  }
+
+  return true;
+}
+
+const uint8_t* patternCode() {
+  return pattern;
+}
+
+size_t patternLength() {
+  return pattern_len;
+}
+
+void fillSegment(uint8_t r, uint8_t g, uint8_t b) {
+  seg_r = r;
+  seg_g = g;
+  seg_b = b;
+  neoFill(strip.Color(r, g, b), seg_start, seg_count);
+}
+
+uint8_t lerp8(uint8_t from, uint8_t to, unsigned long pos, unsigned long total) {
+  return from + (((int)to - (int)from) * (long)pos) / (long)total;
+}
+
+// returns true while the fade is still in progress
+bool renderFade(unsigned long now) {
+  unsigned long elapsed = now - pattern_wait_start;
+
+  if (elapsed >= pattern_wait) {
+    fillSegment(fade_to[0], fade_to[1], fade_to[2]);
+    neoShow();
+    pattern_fading = false;
+    return false;
+  }
+
+  if (now - last_pattern_frame < PATTERN_FRAME_MS) {
+    return true;
+  }
+
+  last_pattern_frame = now;
+  neoFill(strip.Color(
+    lerp8(fade_from[0], fade_to[0], elapsed, pattern_wait),
+    lerp8(fade_from[1], fade_to[1], elapsed, pattern_wait),
+    lerp8(fade_from[2], fade_to[2], elapsed, pattern_wait)
+  ), seg_start, seg_count);
+  neoShow();
+
+  return true;
+}
+
+void patternLoop(bool restart) {
+  if (restart) {
+    patternReset();
+    strip.clear();
+    neoShow();
+  }
+
+  if (pattern_len == 0) {
+    return;
+  }
+
+  unsigned long now = neoNow();
+
+  if (pattern_fading && renderFade(now)) {
+    return;
+  }
+
+  if (pattern_holding) {
+    if (now - pattern_wait_start < pattern_wait) {
+      return;
+    }
+    pattern_holding = false;
+  }
+
+  bool dirty = false;
+
+  // bounded so a tight loop in user bytecode can never stall app.loop()
+  for (uint8_t budget = PATTERN_OPS_PER_FRAME; budget > 0; budget--) {
+    if (pattern_pc >= pattern_len) {
+      pattern_pc = 0;
+      pattern_depth = 0;
+    }
+
+    size_t pc = pattern_pc;
+    uint8_t op = pattern[pc];
+    pattern_pc += PATTERN_OP_ARGS[op] + 1;
+
+    if (op == op_end) {
+      pattern_pc = 0;
+      pattern_depth = 0;
+      break; // yield at the end of every pass
+    } else if (op == op_set) {
+      fillSegment(pattern[pc + 1], pattern[pc + 2], pattern[pc + 3]);
+      dirty = true;
+    } else if (op == op_fade) {
+      fade_from[0] = seg_r;
+      fade_from[1] = seg_g;
+      fade_from[2] = seg_b;
+      fade_to[0] = seg_r = pattern[pc + 1];
+      fade_to[1] = seg_g = pattern[pc + 2];
+      fade_to[2] = seg_b = pattern[pc + 3];
+      pattern_wait = readDuration(pc + 4);
+      pattern_wait_start = now;
+      last_pattern_frame = 0;
+      pattern_fading = true;
+      break;
+    } else if (op == op_hold) {
+      pattern_wait = readDuration(pc + 1);
+      pattern_wait_start = now;
+      pattern_holding = true;
+      break;
+    } else if (op == op_loop) {
+      loop_pc[pattern_depth] = pattern_pc;
+      loop_remaining[pattern_depth] = pattern[pc + 1];
+      pattern_depth++;
+    } else if (op == op_next) {
+      uint8_t top = pattern_depth - 1;
+
+      // a count of 0 loops forever
+      if (loop_remaining[top] == 0 || --loop_remaining[top] > 0) {
+        pattern_pc = loop_pc[top];
+      } else {
+        pattern_depth--;
+      }
+    } else if (op == op_segment) {
+      seg_start = pattern[pc + 1];
+      seg_count = pattern[pc + 2] ? pattern[pc + 2] : strip.numPixels() - seg_start;
+      seg_count = min(seg_count, (uint16_t)(strip.numPixels() - seg_start));
+    }
+  }
+
+  if (dirty) {
+    neoShow();
+  }
+}
@@ -0,0 +1,92 @@
+#include <Arduino.h>
+#include <ESP8266WiFi.h>
+#include "power.h"
+
+bool power_use_wifi = true;
+PowerWakeHook power_arm_wakeup = NULL;
+PowerWakeHook power_disarm_wakeup = NULL;
+bool power_idle = false;
+unsigned long last_activity = 0;
+uint32_t power_sleeps = 0;
+
+// duty cycle bookkeeping, the last full window is what gets reported
+unsigned long window_start = 0;
+unsigned long window_sleep_us = 0;
+uint8_t power_duty = 100;
+
+// the hooks set up a wakeup on the button while we may light sleep, and put it back after
+void powerSetup(bool useWiFi, PowerWakeHook armWakeup, PowerWakeHook disarmWakeup) {
+  power_use_wifi = useWiFi;
+  power_arm_wakeup = armWakeup;
+  power_disarm_wakeup = disarmWakeup;
+  last_activity = millis();
+  window_start = last_activity;
+}
+
+// anything that needs a quick response keeps us awake for a while
+void powerActivity() {
+  last_activity = millis();
+}
+
+void setIdle(bool idle) {
+  power_idle = idle;
+
+  if (!power_use_wifi) {
+    return;
+  }
+
+  // in light sleep the sdk parks the cpu and radio between the DTIM beacons
+  // we listen for whenever we yield, modem sleep only turns the radio off.
+  // while idle a press wakes us straight away, see buttonArmWakeup()
+  if (idle) {
+    power_arm_wakeup();
+    WiFi.setSleepMode(WIFI_LIGHT_SLEEP, POWER_LISTEN_INTERVAL);
+  } else {
+    WiFi.setSleepMode(WIFI_MODEM_SLEEP);
+    power_disarm_wakeup();
+  }
+}
+
+// canSleep means the frame is static and there is nothing left to do this loop
+void powerLoop(bool canSleep) {
+  unsigned long now = millis();
+  bool idle = canSleep && now - last_activity >= POWER_IDLE_AFTER_MS;
+
+  if (idle != power_idle) {
+    setIdle(idle);
+  }
+
+  if (idle) {
+    unsigned long start = micros();
+    delay(POWER_IDLE_SLEEP_MS); // yield, the async server still answers from here
+    window_sleep_us += micros() - start;
+    power_sleeps++;
+  }
+
+  unsigned long elapsed = now - window_start;
+
+  if (elapsed >= POWER_WINDOW_MS) {
+    unsigned long sleptMs = min(window_sleep_us / 1000, elapsed);
+    power_duty = 100 - sleptMs * 100 / elapsed;
+    window_start = now;
+    window_sleep_us = 0;
+  }
+}
+
+bool powerIsIdle() {
+  return power_idle;
+}
+
+// percent of the last window spent awake
+uint8_t powerDutyCycle() {
+  return power_duty;
+}
+
+// module only, the leds are not included
+uint16_t powerEstimatedMilliamps() {
+  return (power_duty * POWER_AWAKE_MA + (100 - power_duty) * POWER_SLEEP_MA) / 100;
+}
+
+uint32_t powerSleepCount() {
+  return power_sleeps;
+}
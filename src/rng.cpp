@@ -0,0 +1,37 @@
+#include <Arduino.h>
+#include "rng.h"
+
+// xorshift32, any non-zero state works
+uint32_t rng_state = 2463534242UL;
+uint32_t rng_seed = rng_state;
+
+void rngSeed(uint32_t seed) {
+  rng_seed = seed ? seed : 2463534242UL;
+  rng_state = rng_seed;
+}
+
+// the ESP8266 has a hardware random number generator fed by the radio
+void rngSeedFromHardware() {
+  rngSeed(ESP.random());
+}
+
+uint32_t rngSeedValue() {
+  return rng_seed;
+}
+
+uint32_t rngNext() {
+  rng_state ^= rng_state << 13;
+  rng_state ^= rng_state >> 17;
+  rng_state ^= rng_state << 5;
+
+  return rng_state;
+}
+
+uint8_t rngByte() {
+  return rngNext() >> 24;
+}
+
+// uniform in [0, n) without a division
+uint16_t rngRange(uint16_t n) {
+  return ((rngNext() >> 16) * n) >> 16;
+}
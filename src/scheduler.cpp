@@ -0,0 +1,125 @@
+#include <Arduino.h>
+#include "scheduler.h"
+
+typedef struct {
+  const char* name;
+  TaskHandler handler;
+  uint8_t priority;
+  unsigned long budget_us;
+  unsigned long last_start;
+  uint32_t runs;
+  uint32_t misses; // started more than SCHEDULER_MAX_DEFER_MS after the last run
+  uint32_t overruns; // took longer than the budget
+  uint32_t max_us;
+} Task;
+
+typedef struct {
+  unsigned long due;
+  TaskHandler handler;
+} Timer;
+
+// kept sorted by priority
+Task tasks[SCHEDULER_MAX_TASKS];
+uint8_t num_tasks = 0;
+
+Timer timers[SCHEDULER_MAX_TIMERS];
+
+bool schedulerAdd(const char* name, TaskHandler handler, uint8_t priority, unsigned long budgetUs) {
+  if (num_tasks >= SCHEDULER_MAX_TASKS) {
+    return false;
+  }
+
+  uint8_t i = num_tasks++;
+  while (i > 0 && tasks[i - 1].priority > priority) {
+    tasks[i] = tasks[i - 1];
+    i--;
+  }
+
+  memset(&tasks[i], 0, sizeof(Task));
+  tasks[i].name = name;
+  tasks[i].handler = handler;
+  tasks[i].priority = priority;
+  tasks[i].budget_us = budgetUs;
+  tasks[i].last_start = millis();
+
+  return true;
+}
+
+// run a handler once, ms from now, instead of blocking in delay()
+bool schedulerAfter(unsigned long ms, TaskHandler handler) {
+  for (uint8_t i = 0; i < SCHEDULER_MAX_TIMERS; i++) {
+    if (!timers[i].handler) {
+      timers[i].due = millis() + ms;
+      timers[i].handler = handler;
+      return true;
+    }
+  }
+
+  return false;
+}
+
+void runTimers() {
+  unsigned long now = millis();
+
+  for (uint8_t i = 0; i < SCHEDULER_MAX_TIMERS; i++) {
+    if (timers[i].handler && (long)(now - timers[i].due) >= 0) {
+      TaskHandler handler = timers[i].handler;
+      timers[i].handler = NULL; // free the slot first so the handler can schedule again
+      handler();
+    }
+  }
+}
+
+void runTask(Task* task) {
+  unsigned long start = micros();
+  unsigned long startMs = millis();
+
+  if (task->runs && startMs - task->last_start > SCHEDULER_MAX_DEFER_MS) {
+    task->misses++;
+  }
+
+  task->last_start = startMs;
+  task->handler();
+
+  unsigned long took = micros() - start;
+  task->runs++;
+  task->max_us = max(task->max_us, (uint32_t)took);
+
+  if (took > task->budget_us) {
+    task->overruns++;
+  }
+
+  ESP.wdtFeed(); // every task ends by feeding the soft watchdog
+}
+
+// one pass: input and render always run, lower priorities fill whatever is
+// left of the pass budget, and anything deferred too long runs regardless
+void schedulerLoop() {
+  unsigned long passStart = micros();
+
+  runTimers();
+
+  for (uint8_t i = 0; i < num_tasks; i++) {
+    Task* task = &tasks[i];
+    bool guaranteed = task->priority <= priority_render;
+    bool overdue = millis() - task->last_start >= SCHEDULER_MAX_DEFER_MS;
+
+    if (!guaranteed && !overdue && micros() - passStart >= SCHEDULER_PASS_BUDGET_US) {
+      continue;
+    }
+
+    runTask(task);
+  }
+}
+
+uint8_t schedulerTaskCount() {
+  return num_tasks;
+}
+
+void schedulerGetTask(uint8_t i, const char** name, uint32_t* runs, uint32_t* misses, uint32_t* overruns, uint32_t* maxUs) {
+  *name = tasks[i].name;
+  *runs = tasks[i].runs;
+  *misses = tasks[i].misses;
+  *overruns = tasks[i].overruns;
+  *maxUs = tasks[i].max_us;
+}
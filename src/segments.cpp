@@ -0,0 +1,158 @@
+#include <Arduino.h>
+#include <Adafruit_NeoPixel.h>
+#include "light.h"
+#include "segments.h"
+
+// base step delay of each mode at speed 3, indexed by NEO_MODES
+const unsigned long SEGMENT_MODE_DELAYS[rainbow_theater_mode + 1] = { 0, 10, 100, 100, 100, 10, 100 };
+
+// segment state is kept as parallel arrays so the render pass stays tight
+uint8_t num_segments = 0;
+uint16_t seg_first[MAX_SEGMENTS];
+uint16_t seg_len[MAX_SEGMENTS];
+uint8_t seg_red[MAX_SEGMENTS];
+uint8_t seg_green[MAX_SEGMENTS];
+uint8_t seg_blue[MAX_SEGMENTS];
+uint8_t seg_mode[MAX_SEGMENTS];
+uint8_t seg_speed[MAX_SEGMENTS];
+uint32_t seg_step[MAX_SEGMENTS];
+unsigned long seg_last_millis[MAX_SEGMENTS];
+bool segments_changed = true;
+
+void segmentsClear() {
+  num_segments = 0;
+  segments_changed = true;
+}
+
+bool segmentsAdd(uint16_t first, uint16_t count, uint8_t r, uint8_t g, uint8_t b, uint8_t neo_mode, uint8_t neo_speed) {
+  if (num_segments >= MAX_SEGMENTS || count == 0 || first + count > strip.numPixels()) {
+    return false;
+  }
+
+  if (neo_mode > rainbow_theater_mode && neo_mode != off_mode) {
+    return false;
+  }
+
+  uint8_t i = num_segments++;
+  seg_first[i] = first;
+  seg_len[i] = count;
+  seg_red[i] = r;
+  seg_green[i] = g;
+  seg_blue[i] = b;
+  seg_mode[i] = neo_mode;
+  seg_speed[i] = neo_speed;
+  seg_step[i] = 0;
+  seg_last_millis[i] = 0;
+  segments_changed = true;
+
+  return true;
+}
+
+uint8_t segmentsCount() {
+  return num_segments;
+}
+
+void segmentsGet(uint8_t i, uint16_t* first, uint16_t* count, uint8_t* rgb, uint8_t* neo_mode, uint8_t* neo_speed) {
+  *first = seg_first[i];
+  *count = seg_len[i];
+  rgb[0] = seg_red[i];
+  rgb[1] = seg_green[i];
+  rgb[2] = seg_blue[i];
+  *neo_mode = seg_mode[i];
+  *neo_speed = seg_speed[i];
+}
+
+// scale a channel by a 0-255 level
+uint8_t scale8(uint8_t value, uint8_t level) {
+  return ((uint16_t)value * (level + 1)) >> 8;
+}
+
+uint32_t rainbowColor(uint32_t hue) {
+  return strip.gamma32(strip.ColorHSV(hue & 0xffff));
+}
+
+// each mode is a pure function of the segment's step, so any segment can be redrawn at any time
+void renderSegment(uint8_t s) {
+  uint16_t first = seg_first[s];
+  uint16_t len = seg_len[s];
+  uint32_t step = seg_step[s];
+  uint32_t color = strip.Color(seg_red[s], seg_green[s], seg_blue[s]);
+
+  switch (seg_mode[s])
+  {
+  case solid_mode:
+    neoFill(color, first, len);
+    break;
+  case breath_mode: {
+    uint8_t level = step & 0xff;
+    level = (step & 0x100) ? 255 - level : level; // triangle wave over 512 steps
+    level = max(level, (uint8_t)5);
+    neoFill(strip.Color(scale8(seg_red[s], level), scale8(seg_green[s], level), scale8(seg_blue[s], level)), first, len);
+    break;
+  }
+  case marquee_mode: {
+    // fill pixel by pixel, then clear pixel by pixel
+    uint16_t pos = step % (len * 2);
+    for (uint16_t i = 0; i < len; i++) {
+      bool lit = pos < len ? i <= pos : i > pos - len;
+      neoSetPixel(first + i, lit ? color : 0);
+    }
+    break;
+  }
+  case theater_mode:
+    for (uint16_t i = 0; i < len; i++) {
+      neoSetPixel(first + i, (i % 3 == step % 3) ? color : 0);
+    }
+    break;
+  case rainbow_mode:
+    neoFill(rainbowColor(step * 256), first, len);
+    break;
+  case rainbow_marquee_mode:
+    for (uint16_t i = 0; i < len; i++) {
+      neoSetPixel(first + len - 1 - i, rainbowColor(step * 256 + i * 65536L / len));
+    }
+    break;
+  case rainbow_theater_mode:
+    for (uint16_t i = 0; i < len; i++) {
+      uint32_t hue = step * (65536 / 90) + i * 65536L / len;
+      neoSetPixel(first + i, (i % 3 == step % 3) ? rainbowColor(hue) : 0);
+    }
+    break;
+  default:
+    neoFill(0, first, len);
+    break;
+  }
+}
+
+void segmentsLoop(bool restart, bool redraw) {
+  unsigned long now = neoNow();
+  restart = restart || segments_changed;
+  segments_changed = false;
+  bool dirty = restart || redraw;
+
+  for (uint8_t s = 0; s < num_segments; s++) {
+    if (restart) {
+      seg_step[s] = 0;
+      seg_last_millis[s] = now;
+    } else if (seg_mode[s] <= rainbow_theater_mode && SEGMENT_MODE_DELAYS[seg_mode[s]]) {
+      unsigned long segDelay = getDelayForSpeed(SEGMENT_MODE_DELAYS[seg_mode[s]], seg_speed[s]);
+
+      if (now - seg_last_millis[s] >= segDelay) {
+        seg_step[s]++;
+        seg_last_millis[s] = now;
+        dirty = true;
+      }
+    }
+  }
+
+  if (!dirty) {
+    return;
+  }
+
+  // one pass over the frame buffer, one show()
+  strip.clear();
+  for (uint8_t s = 0; s < num_segments; s++) {
+    renderSegment(s);
+  }
+  neoShow();
+}
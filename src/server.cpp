@@ -0,0 +1,370 @@
+#include <Arduino.h>
+#include <ESPAsyncTCP.h>        // https://github.com/me-no-dev/ESPAsyncTCP
+#include <ESPAsyncWebServer.h>  // https://github.com/me-no-dev/ESPAsyncWebServer
+
+#include "helpers.h"
+#include "server.h"
+#include "www.h"
+
+typedef struct {
+  uint32_t hash;
+  uint8_t route;
+} RouteIndex;
+
+typedef struct {
+  uint32_t ip;
+  uint16_t tokens; // thousandths of a request
+  unsigned long last;
+} RateBucket;
+
+// an api request waiting for the next frame
+typedef struct {
+  AsyncWebServerRequest* request;
+  const Route* route;
+  const char* arg;
+} ParkedRequest;
+
+// requests are handled from the network stack as they arrive, so a slow
+// client never holds up the animation in neoLoop() or any other client
+AsyncWebServer server(SERVER_PORT);
+uint8_t active_requests = 0;
+
+// every path and alias, sorted by hash
+const Route* routes = NULL;
+RouteIndex route_index[SERVER_MAX_ROUTES];
+uint8_t num_route_index = 0;
+
+RateBucket rate_buckets[SERVER_RATE_CLIENTS];
+
+// a slot is freed as soon as its client goes, so the entry may outlive it until the next frame
+ParkedRequest parked[SERVER_MAX_CONNECTIONS];
+uint8_t num_parked = 0;
+
+uint32_t hashBytes(const char* bytes, size_t len, uint32_t hash) {
+  for (size_t i = 0; i < len; i++) {
+    hash = (hash ^ (uint8_t)bytes[i]) * 16777619UL;
+  }
+
+  return hash;
+}
+
+void addRouteIndex(uint32_t hash, uint8_t route) {
+  if (num_route_index >= SERVER_MAX_ROUTES) {
+    Serial.println(F("[ERROR] Too many routes, increase SERVER_MAX_ROUTES"));
+    return;
+  }
+
+  // insertion sort, there are only a few dozen routes and this runs once
+  uint8_t i = num_route_index++;
+  while (i > 0 && route_index[i - 1].hash > hash) {
+    route_index[i] = route_index[i - 1];
+    i--;
+  }
+
+  route_index[i].hash = hash;
+  route_index[i].route = route;
+}
+
+bool routeMatches(const Route* route, uint8_t method, const char* path, size_t len) {
+  if (route->method != method) {
+    return false;
+  }
+
+  // paths are in flash
+  if (!strncmp_P(path, route->path, len) && !pgm_read_byte(route->path + len)) {
+    return true;
+  }
+
+  return route->alias && !strncmp_P(path, route->alias, len) && !pgm_read_byte(route->alias + len);
+}
+
+// binary search for the first index entry with this hash
+uint8_t firstRouteIndex(uint32_t hash) {
+  uint8_t lo = 0;
+  uint8_t hi = num_route_index;
+
+  while (lo < hi) {
+    uint8_t mid = (lo + hi) / 2;
+
+    if (route_index[mid].hash < hash) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+
+  return lo;
+}
+
+// exact paths first, then a wildcard on the last segment, confirming the path in case of a hash collision
+const Route* lookupRoute(uint8_t method, const char* path, const char** param) {
+  size_t len = strlen(path);
+  uint32_t hash = hashBytes(path, len, 2166136261UL ^ method);
+
+  for (uint8_t i = firstRouteIndex(hash); i < num_route_index && route_index[i].hash == hash; i++) {
+    const Route* route = &routes[route_index[i].route];
+
+    if (routeMatches(route, method, path, len)) {
+      return route;
+    }
+  }
+
+  const char* slash = strrchr(path, '/');
+
+  if (!slash || !slash[1]) {
+    return NULL;
+  }
+
+  // hash "/prefix/*" without building the string
+  size_t prefixLen = slash + 1 - path;
+  hash = hashBytes("*", 1, hashBytes(path, prefixLen, 2166136261UL ^ method));
+
+  for (uint8_t i = firstRouteIndex(hash); i < num_route_index && route_index[i].hash == hash; i++) {
+    const Route* route = &routes[route_index[i].route];
+
+    if (route->method == method && !strncmp_P(path, route->path, prefixLen) && !strcmp_P("*", route->path + prefixLen)) {
+      *param = slash + 1;
+      return route;
+    }
+  }
+
+  return NULL;
+}
+
+// token bucket per client ip, refilled continuously
+bool takeToken(uint32_t ip) {
+  unsigned long now = millis();
+  RateBucket* bucket = &rate_buckets[0];
+
+  for (uint8_t i = 0; i < SERVER_RATE_CLIENTS; i++) {
+    if (rate_buckets[i].ip == ip) {
+      bucket = &rate_buckets[i];
+      break;
+    }
+
+    if (now - rate_buckets[i].last > now - bucket->last) {
+      bucket = &rate_buckets[i];
+    }
+  }
+
+  if (bucket->ip != ip) {
+    bucket->ip = ip;
+    bucket->tokens = SERVER_RATE_BURST * 1000;
+  } else {
+    unsigned long elapsed = min(now - bucket->last, (unsigned long)(SERVER_RATE_BURST * 1000 / SERVER_RATE_PER_SEC));
+    bucket->tokens = min((unsigned long)bucket->tokens + elapsed * SERVER_RATE_PER_SEC, (unsigned long)(SERVER_RATE_BURST * 1000));
+  }
+
+  bucket->last = now;
+
+  if (bucket->tokens < 1000) {
+    return false;
+  }
+
+  bucket->tokens -= 1000;
+  return true;
+}
+
+void sendJson(AsyncWebServerRequest* request, int code, String json) {
+  request->send(code, "application/json", json);
+}
+
+void unpark(AsyncWebServerRequest* request) {
+  for (uint8_t i = 0; i < num_parked; i++) {
+    if (parked[i].request == request) {
+      parked[i].request = NULL;
+    }
+  }
+}
+
+// claim a slot in the connection pool, or turn the request away
+bool acquireSlot(AsyncWebServerRequest* request) {
+  if (active_requests >= SERVER_MAX_CONNECTIONS) {
+    request->send(503);
+    return false;
+  }
+
+  active_requests++;
+  request->onDisconnect([request]() {
+    active_requests--;
+    unpark(request); // never answer a request that's gone
+  });
+
+  return true;
+}
+
+// buffer the body per request, the buffer is freed with the request
+void handleBody(AsyncWebServerRequest* request, uint8_t* data, size_t len, size_t index, size_t total) {
+  if (total > SERVER_MAX_BODY) {
+    return;
+  }
+
+  if (index == 0) {
+    request->_tempObject = malloc(total + 1);
+  }
+
+  if (request->_tempObject) {
+    char* body = (char*)request->_tempObject;
+    memcpy(body + index, data, len);
+    body[index + len] = '\0';
+  }
+}
+
+// assets are stored gzipped in flash and streamed out in chunks, never copied to RAM
+void serveAsset(AsyncWebServerRequest* request, const WwwAsset* asset) {
+  AsyncWebServerResponse* response;
+
+  if (request->hasHeader(F("If-None-Match")) && !strcmp_P(request->getHeader(F("If-None-Match"))->value().c_str(), asset->etag)) {
+    response = request->beginResponse(304);
+  } else {
+    response = request->beginResponse_P(200, String(FPSTR(asset->type)), asset->data, asset->len);
+    response->addHeader(F("Content-Encoding"), F("gzip"));
+  }
+
+  response->addHeader(F("ETag"), FPSTR(asset->etag));
+  response->addHeader(F("Cache-Control"), FPSTR(asset->cacheControl));
+  request->send(response);
+}
+
+// the table is in flash, so a match is copied into asset
+bool findAsset(const char* path, WwwAsset* asset) {
+  for (size_t i = 0; i < WWW_NUM_ASSETS; i++) {
+    memcpy_P(asset, &WWW_ASSETS[i], sizeof(WwwAsset));
+
+    if (!strcmp_P(path, asset->path)) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+// every request lands here and is dispatched from our own table
+void handleRequest(AsyncWebServerRequest* request) {
+  if (request->method() == HTTP_OPTIONS) {
+    request->send(204);
+    return;
+  }
+
+  // anything else would otherwise be served as if it were a GET
+  if (request->method() != HTTP_GET && request->method() != HTTP_POST) {
+    AsyncWebServerResponse* response = request->beginResponse(405);
+    response->addHeader(F("Allow"), F("GET, POST, OPTIONS"));
+    request->send(response);
+    return;
+  }
+
+  uint8_t method = request->method() == HTTP_POST ? route_post : route_get;
+  const char* path = request->url().c_str();
+  const char* param = NULL;
+  const Route* route = lookupRoute(method, path, &param);
+  WwwAsset found;
+  const WwwAsset* asset = (!route && method == route_get && findAsset(path, &found)) ? &found : NULL;
+
+  if (!route && !asset) {
+    sendJson(request, 404, makeErrorJson("Not found"));
+    return;
+  }
+
+  // no body, nothing serialized, so a flood costs us as little as possible
+  if (route && !takeToken(request->client()->getRemoteAddress())) {
+    request->send(429);
+    return;
+  }
+
+  if (!acquireSlot(request)) {
+    return;
+  }
+
+  if (asset) {
+    serveAsset(request, asset);
+  } else if (method == route_post && !request->_tempObject) {
+    sendJson(request, 413, makeErrorJson("Body is missing or too large."));
+  } else if (num_parked >= SERVER_MAX_CONNECTIONS) {
+    request->send(503); // clients that dropped out still hold their place until the next frame
+  } else {
+    // handled on the next frame in serverLoop()
+    parked[num_parked].request = request;
+    parked[num_parked].route = route;
+    parked[num_parked].arg = method == route_get ? param : (char*)request->_tempObject;
+    num_parked++;
+  }
+}
+
+void serverBegin(const Route* allRoutes, uint8_t numRoutes) {
+  routes = allRoutes;
+
+  for (uint8_t i = 0; i < numRoutes; i++) {
+    addRouteIndex(routes[i].hash, i);
+
+    if (routes[i].alias) {
+      addRouteIndex(routes[i].aliasHash, i);
+    }
+  }
+
+  DefaultHeaders::Instance().addHeader(F("Access-Control-Allow-Origin"), F("*"));
+  DefaultHeaders::Instance().addHeader(F("Access-Control-Allow-Methods"), F("GET, POST, OPTIONS"));
+  DefaultHeaders::Instance().addHeader(F("Access-Control-Allow-Headers"), F("Content-Type"));
+  server.onNotFound(handleRequest);
+  server.onRequestBody(handleBody);
+  server.begin();
+}
+
+void serverAddHandler(AsyncWebHandler* handler) {
+  server.addHandler(handler);
+}
+
+// run each argument-free GET at most once per frame and give every request
+// for it the same answer. bodies and path arguments are all applied, in the
+// order they arrived, so no write is lost.
+// returns true if any request was answered
+bool serverLoop() {
+  bool answered = num_parked > 0;
+
+  for (uint8_t i = 0; i < num_parked; i++) {
+    const Route* route = parked[i].route;
+    bool waiting = false;
+
+    if (!route) {
+      continue; // already answered
+    }
+
+    if (!route->get) {
+      // the argument belongs to the request, so it's gone if the client is
+      if (parked[i].request) {
+        sendJson(parked[i].request, 200, route->withArg(parked[i].arg));
+      }
+
+      parked[i].route = NULL;
+      continue;
+    }
+
+    for (uint8_t j = i; j < num_parked; j++) {
+      if (parked[j].route == route && parked[j].request) {
+        waiting = true;
+      }
+    }
+
+    String json;
+
+    if (waiting) {
+      json = route->get();
+    }
+
+    for (uint8_t j = i; j < num_parked; j++) {
+      if (parked[j].route != route) {
+        continue;
+      }
+
+      if (parked[j].request) {
+        sendJson(parked[j].request, 200, json);
+      }
+
+      parked[j].route = NULL;
+    }
+  }
+
+  num_parked = 0;
+
+  return answered;
+}
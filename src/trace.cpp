@@ -0,0 +1,240 @@
+#include <Arduino.h>
+
+#include "light.h"
+#include "rng.h"
+#include "trace.h"
+
+// 16 bytes, so the whole ring is 1KB
+struct TraceRecord {
+  uint32_t at; // ms on the renderer's clock
+  uint8_t type;
+  uint8_t mode;
+  uint16_t show_us; // frames: how long show() took
+  uint32_t gap_us; // frames: since the frame before
+  uint32_t value; // frames: estimated mA, state changes: the new value
+};
+
+const char TRACE_FRAME[] PROGMEM = "frame";
+const char TRACE_COLOR[] PROGMEM = "color";
+const char TRACE_BRIGHTNESS[] PROGMEM = "brightness";
+const char TRACE_RATE[] PROGMEM = "rate";
+const char TRACE_MODE[] PROGMEM = "mode";
+
+const char* const TRACE_TYPE_NAMES[] PROGMEM = { TRACE_FRAME, TRACE_COLOR, TRACE_BRIGHTNESS, TRACE_RATE, TRACE_MODE };
+
+TraceRecord trace[TRACE_SIZE];
+uint8_t trace_head = 0;
+uint8_t trace_count = 0;
+bool trace_recording = false;
+uint32_t trace_seed = 0;
+uint32_t trace_frames = 0;
+unsigned long last_trace_frame_us = 0;
+
+// what recording costs, measured on every frame
+unsigned long trace_overhead_max_us = 0;
+unsigned long trace_overhead_total_us = 0;
+uint32_t trace_over_budget = 0;
+
+TraceRecord* nextRecord(uint8_t type) {
+  TraceRecord* record = &trace[trace_head];
+  trace_head = (trace_head + 1) % TRACE_SIZE;
+  trace_count = min(trace_count + 1, TRACE_SIZE);
+
+  record->at = neoNow();
+  record->type = type;
+  record->mode = neoCurrentMode();
+  record->show_us = 0;
+  record->gap_us = 0;
+  record->value = 0;
+
+  return record;
+}
+
+void traceFrame(unsigned long time, unsigned long showUs) {
+  unsigned long start = micros();
+  TraceRecord* record = nextRecord(trace_frame);
+
+  record->at = time;
+  record->show_us = min(showUs, 0xffffUL);
+  record->gap_us = last_trace_frame_us ? start - last_trace_frame_us : 0;
+  record->value = neoEstimatedMilliamps();
+  last_trace_frame_us = start;
+  trace_frames++;
+
+  unsigned long took = micros() - start;
+  trace_overhead_max_us = max(trace_overhead_max_us, took);
+  trace_overhead_total_us += took;
+
+  if (took > TRACE_BUDGET_US) {
+    trace_over_budget++;
+  }
+}
+
+// the caller records the current state straight after, so a replay knows where it started
+void traceStart(uint32_t seed) {
+  trace_head = 0;
+  trace_count = 0;
+  trace_seed = seed;
+  trace_frames = 0;
+  last_trace_frame_us = 0;
+  trace_overhead_max_us = 0;
+  trace_overhead_total_us = 0;
+  trace_over_budget = 0;
+  trace_recording = true;
+
+  neoSetFrameHook(traceFrame);
+}
+
+void traceStop() {
+  trace_recording = false;
+  neoSetFrameHook(NULL);
+}
+
+bool traceIsRecording() {
+  return trace_recording;
+}
+
+void traceState(uint8_t type, uint32_t value) {
+  if (trace_recording) {
+    nextRecord(type)->value = value;
+  }
+}
+
+// built by hand, a document for every record would need several KB of heap
+String traceGetAsJson() {
+  String output;
+  char line[96];
+  char type[12];
+
+  output.reserve(160 + trace_count * 48);
+  snprintf_P(line, sizeof(line), PSTR("{\"recording\":%s,\"seed\":%lu,\"frames\":%lu,\"budget_us\":%d,"),
+    trace_recording ? "true" : "false", (unsigned long)trace_seed, (unsigned long)trace_frames, TRACE_BUDGET_US);
+  output += line;
+  snprintf_P(line, sizeof(line), PSTR("\"overhead_max_us\":%lu,\"overhead_avg_us\":%lu,\"over_budget\":%lu,\"records\":["),
+    trace_overhead_max_us, trace_frames ? trace_overhead_total_us / trace_frames : 0, (unsigned long)trace_over_budget);
+  output += line;
+
+  // oldest first, so it reads as a timeline
+  for (uint8_t i = 0; i < trace_count; i++) {
+    TraceRecord* record = &trace[(trace_head + TRACE_SIZE - trace_count + i) % TRACE_SIZE];
+
+    if (record->type == trace_frame) {
+      snprintf_P(line, sizeof(line), PSTR("%s[\"frame\",%lu,%u,%u,%lu,%lu]"), i ? "," : "",
+        (unsigned long)record->at, record->mode, record->show_us, (unsigned long)record->gap_us, (unsigned long)record->value);
+    } else {
+      strlcpy_P(type, (PGM_P)pgm_read_ptr(&TRACE_TYPE_NAMES[record->type]), sizeof(type));
+      snprintf_P(line, sizeof(line), PSTR("%s[\"%s\",%lu,%u,%lu]"), i ? "," : "",
+        type, (unsigned long)record->at, record->mode, (unsigned long)record->value);
+    }
+
+    output += line;
+  }
+
+  output += F("]}");
+
+  return output;
+}
+
+// replays run on their own clock, which only moves between calls to neoLoop()
+unsigned long replay_now = 0;
+uint32_t replay_frames = 0;
+uint32_t replay_last_hash = 0;
+String* replay_log = NULL;
+
+unsigned long replayClock() {
+  return replay_now;
+}
+
+// FNV-1a of the frame as it sits in the strip's buffer
+uint32_t hashFrame() {
+  const uint8_t* pixels = neoPixels();
+  uint32_t hash = 2166136261UL;
+
+  for (uint16_t i = 0; i < neoPixelBytes(); i++) {
+    hash = (hash ^ pixels[i]) * 16777619UL;
+  }
+
+  return hash;
+}
+
+void replayFrame(unsigned long time, unsigned long showUs) {
+  char entry[24];
+
+  replay_last_hash = hashFrame();
+
+  if (replay_frames < TRACE_REPLAY_MAX_LOG) {
+    snprintf_P(entry, sizeof(entry), PSTR("%s[%lu,\"%08lx\"]"), replay_frames ? "," : "", time, (unsigned long)replay_last_hash);
+    *replay_log += entry;
+  }
+
+  replay_frames++;
+}
+
+// render a mode from scratch on a fake clock that moves step ms per neoLoop(),
+// without touching the strip, and log every frame it shows. a mode should land
+// on the same frame after the same time whatever the step, and the same
+// settings always give the same log. the caller puts the real state back after
+String traceReplay(uint8_t mode, uint32_t color, uint8_t brightness, uint16_t rate, uint32_t seed, unsigned long ms, unsigned long step) {
+  String output;
+  String log;
+  char line[128];
+
+  ms = min(ms, (unsigned long)TRACE_REPLAY_MAX_MS);
+  step = constrain(step, 1UL, (unsigned long)NEO_MAX_ELAPSED_MS);
+
+  log.reserve(min(ms / step + 1, (unsigned long)TRACE_REPLAY_MAX_LOG) * 16);
+  replay_log = &log;
+  replay_frames = 0;
+  replay_last_hash = 0;
+  replay_now = 0;
+
+  uint32_t steps = neoStepCount();
+  uint32_t dropped = neoDroppedStepCount();
+  rngSeed(seed);
+  neoSetClock(replayClock);
+  neoSetOutput(false);
+  neoSetFrameHook(replayFrame);
+  neoRestart();
+
+  neoSetColor((uint8_t)(color >> 16), (uint8_t)(color >> 8), (uint8_t)color);
+  neoSetBrightness(brightness);
+  neoSetRate(rate);
+  neoSetMode(mode);
+
+  // the last step is cut short, so every step size ends at exactly ms
+  for (replay_now = 0; ; replay_now = min(replay_now + step, ms)) {
+    neoLoop();
+
+    if (replay_now >= ms) {
+      break;
+    }
+
+    yield();
+  }
+
+  // steps still owed at the end are worked off with the clock stopped
+  while (neoOwedSteps()) {
+    neoLoop();
+  }
+
+  steps = neoStepCount() - steps;
+  dropped = neoDroppedStepCount() - dropped;
+
+  neoSetFrameHook(NULL);
+  neoSetOutput(true);
+  neoSetClock(NULL);
+  neoRestart();
+  replay_log = NULL;
+
+  snprintf_P(line, sizeof(line), PSTR("{\"mode\":%u,\"color\":\"%06lx\",\"brightness\":%u,\"rate\":%u,\"seed\":%lu,"),
+    mode, (unsigned long)color, brightness, rate, (unsigned long)seed);
+  output.reserve(log.length() + 256);
+  output += line;
+  snprintf_P(line, sizeof(line), PSTR("\"ms\":%lu,\"step\":%lu,\"frames\":%lu,\"steps\":%lu,\"dropped\":%lu,\"final\":\"%08lx\",\"log\":["),
+    ms, step, (unsigned long)replay_frames, (unsigned long)steps, (unsigned long)dropped, (unsigned long)replay_last_hash);
+  output += line;
+  output += log;
+  output += F("]}");
+
+  return output;
+}
@@ -0,0 +1,106 @@
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include <ESPAsyncWebServer.h>  // https://github.com/me-no-dev/ESPAsyncWebServer
+
+#include "light.h"
+#include "server.h"
+#include "websocket.h"
+
+AsyncWebSocket ws(WEBSOCKET_PATH);
+
+LiveUpdateHandler live_on_update = NULL;
+LiveStateGetter live_get_state = NULL;
+LiveVersionGetter live_get_version = NULL;
+
+// written from the network stack, applied once per frame from the loop
+LiveUpdate pending_update;
+bool update_pending = false;
+uint32_t pushed_version = 0;
+
+// read as an int, so 256 or -1 can't wrap around into a valid byte
+uint8_t readClamped(JsonVariant value, int high) {
+  return constrain(value.as<int>(), 0, high);
+}
+
+void handleLiveMessage(uint8_t* data, size_t len) {
+  StaticJsonDocument<128> message;
+
+  if (deserializeJson(message, (const char*)data, len)) {
+    return;
+  }
+
+  // last writer wins, so a fast slider only costs one state change per frame
+  if (message.containsKey("color")) {
+    pending_update.hasColor = true;
+    pending_update.r = readClamped(message["color"][0], 255);
+    pending_update.g = readClamped(message["color"][1], 255);
+    pending_update.b = readClamped(message["color"][2], 255);
+
+    if (message["color"].size() > 3) {
+      pending_update.hasBrightness = true;
+      pending_update.a = readClamped(message["color"][3], NEO_BRIGHTNESS_MAX);
+    }
+  }
+
+  if (message.containsKey("brightness")) {
+    pending_update.hasBrightness = true;
+    pending_update.a = readClamped(message["brightness"], NEO_BRIGHTNESS_MAX);
+  }
+
+  if (message.containsKey("speed")) {
+    pending_update.hasSpeed = true;
+    pending_update.speed = readClamped(message["speed"], 255); // the range is checked when it's applied
+  }
+
+  update_pending = pending_update.hasColor || pending_update.hasBrightness || pending_update.hasSpeed;
+}
+
+void handleSocketEvent(AsyncWebSocket* server, AsyncWebSocketClient* client, AwsEventType type, void* arg, uint8_t* data, size_t len) {
+  if (type == WS_EVT_CONNECT) {
+    if (server->count() > WEBSOCKET_MAX_CLIENTS) {
+      client->close();
+      return;
+    }
+
+    client->text(live_get_state());
+  } else if (type == WS_EVT_DATA) {
+    AwsFrameInfo* info = (AwsFrameInfo*)arg;
+
+    // updates are tiny, so only whole single frame text messages are accepted
+    if (info->final && info->index == 0 && info->len == len && info->opcode == WS_TEXT) {
+      handleLiveMessage(data, len);
+    }
+  }
+}
+
+void websocketSetup(LiveUpdateHandler onUpdate, LiveStateGetter getState, LiveVersionGetter getVersion) {
+  live_on_update = onUpdate;
+  live_get_state = getState;
+  live_get_version = getVersion;
+  pushed_version = getVersion();
+
+  ws.onEvent(handleSocketEvent);
+  serverAddHandler(&ws);
+}
+
+void websocketLoop() {
+  if (update_pending) {
+    LiveUpdate update = pending_update;
+    memset(&pending_update, 0, sizeof(pending_update));
+    update_pending = false;
+
+    live_on_update(update);
+  }
+
+  // push every change to every portal, whoever made it
+  uint32_t version = live_get_version();
+  if (version != pushed_version) {
+    pushed_version = version;
+
+    if (ws.count()) {
+      ws.textAll(live_get_state());
+    }
+  }
+
+  ws.cleanupClients(WEBSOCKET_MAX_CLIENTS);
+}
@@ -0,0 +1,55 @@
+// The parts of Adafruit_NeoPixel that include/pixels.h uses: the byte order
+// constants and the pixel buffer. show() is left out, nothing is driven here.
+#ifndef ADAFRUIT_NEOPIXEL_H
+#define ADAFRUIT_NEOPIXEL_H
+
+#include <Arduino.h>
+
+typedef uint16_t neoPixelType;
+
+// offsets of white, red, green and blue, 2 bits each
+#define NEO_RGB ((0 << 6) | (0 << 4) | (1 << 2) | (2))
+#define NEO_GRB ((1 << 6) | (1 << 4) | (0 << 2) | (2))
+#define NEO_GRBW ((3 << 6) | (1 << 4) | (0 << 2) | (2))
+#define NEO_KHZ800 0x0000
+
+class Adafruit_NeoPixel {
+ public:
+  Adafruit_NeoPixel(uint16_t n, int16_t pin, neoPixelType type) : numLEDs(n), brightness(0) {
+    uint8_t bytes = ((type >> 6) & 3) == ((type >> 4) & 3) ? 3 : 4;
+    numBytes = n * bytes;
+    pixels = new uint8_t[numBytes]();
+  }
+
+  ~Adafruit_NeoPixel() {
+    delete[] pixels;
+  }
+
+  void setBrightness(uint8_t b) {
+    brightness = b;
+  }
+
+  uint8_t getBrightness() const {
+    return brightness;
+  }
+
+  uint8_t* getPixels() const {
+    return pixels;
+  }
+
+  uint16_t numPixels() const {
+    return numLEDs;
+  }
+
+  void clear() {
+    memset(pixels, 0, numBytes);
+  }
+
+ private:
+  uint16_t numLEDs;
+  uint16_t numBytes;
+  uint8_t brightness;
+  uint8_t* pixels;
+};
+
+#endif
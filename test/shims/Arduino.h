@@ -0,0 +1,93 @@
+// Just enough of the ESP8266 Arduino core to build the modules under test on
+// the host. Time only moves when a test moves it.
+#ifndef Arduino_h
+#define Arduino_h
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <math.h>
+#include <algorithm>
+#include <string>
+
+using std::min;
+using std::max;
+
+typedef uint8_t byte;
+
+// only so headers that pass strings around can be included
+class String : public std::string {
+  using std::string::string;
+};
+
+#define PI 3.1415926535897932384626433832795
+#define A0 17
+
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+#define PROGMEM
+#define ICACHE_RAM_ATTR
+#define pgm_read_byte(addr) (*(const uint8_t*)(addr))
+
+// the fake clock, in microseconds
+inline unsigned long& shimMicros() {
+  static unsigned long us = 0;
+  return us;
+}
+
+inline unsigned long micros() {
+  return shimMicros();
+}
+
+inline unsigned long millis() {
+  return shimMicros() / 1000;
+}
+
+inline void delay(unsigned long ms) {
+  shimMicros() += ms * 1000;
+}
+
+inline uint16_t analogRead(uint8_t pin) {
+  return 512;
+}
+
+// gpio levels and the interrupt type field of each pin's control register,
+// the tests set the levels and call the interrupt handlers themselves
+#define D5 14
+#define INPUT_PULLUP 0x02
+#define CHANGE 0x03
+#define GPCI 7
+#define GPIP(p) ((shimPins() >> (p)) & 1)
+#define GPC(p) shimGpc(p)
+#define digitalPinToInterrupt(p) (p)
+
+inline uint32_t& shimPins() {
+  static uint32_t levels = 0xffffffff; // pulled up
+  return levels;
+}
+
+inline uint32_t& shimGpc(uint8_t pin) {
+  static uint32_t regs[17];
+  return regs[pin];
+}
+
+inline void pinMode(uint8_t pin, uint8_t mode) {}
+
+inline void attachInterrupt(uint8_t pin, void (*handler)(), int mode) {
+  GPC(pin) = (GPC(pin) & ~(0xF << GPCI)) | ((mode & 0xF) << GPCI);
+}
+
+inline void noInterrupts() {}
+inline void interrupts() {}
+
+struct EspClass {
+  uint32_t random() {
+    return 0x9e3779b9;
+  }
+
+  void wdtFeed() {}
+};
+
+static EspClass ESP;
+
+#endif
@@ -0,0 +1,21 @@
+// The light sleep wakeup from the ESP8266 SDK. Like the real one, it takes
+// over the interrupt type field of the pin it's set on.
+#ifndef USER_INTERFACE_H
+#define USER_INTERFACE_H
+
+typedef enum {
+  GPIO_PIN_INTR_DISABLE = 0,
+  GPIO_PIN_INTR_POSEDGE = 1,
+  GPIO_PIN_INTR_NEGEDGE = 2,
+  GPIO_PIN_INTR_ANYEDGE = 3,
+  GPIO_PIN_INTR_LOLEVEL = 4,
+  GPIO_PIN_INTR_HILEVEL = 5
+} GPIO_INT_TYPE;
+
+inline void wifi_enable_gpio_wakeup(uint32_t pin, GPIO_INT_TYPE type) {
+  GPC(pin) = (GPC(pin) & ~(0xF << GPCI)) | (type << GPCI);
+}
+
+inline void wifi_disable_gpio_wakeup() {}
+
+#endif
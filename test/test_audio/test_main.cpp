@@ -0,0 +1,265 @@
+#include <Arduino.h>
+#include <unity.h>
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+
+#include "audio.h"
+#include "rng.h"
+
+// set AUDIO_WAV to a 16 bit PCM recording to see the band levels it gives
+#define WAV_PATH "audio_test.wav"
+#define WAV_RATE 16000
+
+const uint16_t BAND_HZ[AUDIO_NUM_BANDS] = { 62, 94, 156, 250, 375, 500, 687, 937 };
+
+struct Wav {
+  uint32_t rate;
+  std::vector<int16_t> samples; // the first channel
+};
+
+unsigned long now_us = 0; // when the next sample is taken, carried across tests
+
+void write32(FILE* f, uint32_t v) {
+  fwrite(&v, 4, 1, f);
+}
+
+void write16(FILE* f, uint16_t v) {
+  fwrite(&v, 2, 1, f);
+}
+
+void writeTone(const char* path, float hz, float amplitude, float seconds) {
+  uint32_t count = WAV_RATE * seconds;
+  FILE* f = fopen(path, "wb");
+
+  fwrite("RIFF", 1, 4, f);
+  write32(f, 36 + count * 2);
+  fwrite("WAVEfmt ", 1, 8, f);
+  write32(f, 16);
+  write16(f, 1); // pcm
+  write16(f, 1); // mono
+  write32(f, WAV_RATE);
+  write32(f, WAV_RATE * 2);
+  write16(f, 2);
+  write16(f, 16);
+  fwrite("data", 1, 4, f);
+  write32(f, count * 2);
+
+  for (uint32_t i = 0; i < count; i++) {
+    write16(f, (int16_t)(amplitude * 32767 * sin(2 * PI * hz * i / WAV_RATE)));
+  }
+
+  fclose(f);
+}
+
+bool readWav(const char* path, Wav* wav) {
+  FILE* f = fopen(path, "rb");
+  char id[4];
+  uint32_t size;
+  uint16_t channels = 1;
+  uint16_t bits = 0;
+
+  if (!f || fread(id, 1, 4, f) != 4 || memcmp(id, "RIFF", 4) || fread(&size, 4, 1, f) != 1 || fread(id, 1, 4, f) != 4 || memcmp(id, "WAVE", 4)) {
+    if (f) {
+      fclose(f);
+    }
+
+    return false;
+  }
+
+  while (fread(id, 1, 4, f) == 4 && fread(&size, 4, 1, f) == 1) {
+    if (!memcmp(id, "fmt ", 4)) {
+      uint16_t format;
+      fread(&format, 2, 1, f);
+      fread(&channels, 2, 1, f);
+      fread(&wav->rate, 4, 1, f);
+      fseek(f, 6, SEEK_CUR);
+      fread(&bits, 2, 1, f);
+      fseek(f, size - 16, SEEK_CUR);
+    } else if (!memcmp(id, "data", 4) && bits == 16) {
+      std::vector<int16_t> frames(size / 2);
+      fread(frames.data(), 2, frames.size(), f);
+
+      for (size_t i = 0; i < frames.size(); i += channels) {
+        wav->samples.push_back(frames[i]);
+      }
+
+      fclose(f);
+      return true;
+    } else {
+      fseek(f, size + (size & 1), SEEK_CUR);
+    }
+  }
+
+  fclose(f);
+  return false;
+}
+
+// the microphone module swings the 10 bit ADC around mid scale
+uint16_t toAdc(int16_t sample) {
+  return constrain(512 + sample / 64, 0, 1023);
+}
+
+// sample the recording the way the loop would: every period, give or take
+// jitter, and not at all for stallMs out of every stallEveryMs
+void feed(const Wav& wav, unsigned long jitterUs, unsigned long stallMs, unsigned long stallEveryMs) {
+  unsigned long start = now_us;
+  unsigned long end = start + (uint64_t)wav.samples.size() * 1000000 / wav.rate;
+  unsigned long period = 1000000 / AUDIO_SAMPLE_RATE;
+
+  while (now_us < end) {
+    unsigned long at = now_us - start;
+    audioPushSample(toAdc(wav.samples[(uint64_t)at * wav.rate / 1000000]), now_us);
+    now_us += period + (jitterUs ? rngRange(jitterUs) : 0);
+
+    if (stallEveryMs && (now_us - start) / 1000 % stallEveryMs < stallMs) {
+      now_us += stallMs * 1000;
+    }
+  }
+}
+
+void feedTone(float hz, float amplitude, unsigned long jitterUs, unsigned long stallMs, unsigned long stallEveryMs) {
+  Wav wav;
+  writeTone(WAV_PATH, hz, amplitude, 1.0);
+  TEST_ASSERT_TRUE(readWav(WAV_PATH, &wav));
+  TEST_ASSERT_EQUAL_UINT32(WAV_RATE, wav.rate);
+  feed(wav, jitterUs, stallMs, stallEveryMs);
+}
+
+uint8_t loudestBand() {
+  uint8_t loudest = 0;
+
+  for (uint8_t band = 1; band < AUDIO_NUM_BANDS; band++) {
+    if (audioBandLevel(band) > audioBandLevel(loudest)) {
+      loudest = band;
+    }
+  }
+
+  return loudest;
+}
+
+void setUp() {
+  feedTone(0, 0, 0, 0, 0); // let the last test's levels fall away
+}
+
+void tearDown() {
+  remove(WAV_PATH);
+}
+
+void test_silence_is_dark() {
+  for (uint8_t band = 0; band < AUDIO_NUM_BANDS; band++) {
+    TEST_ASSERT_EQUAL_UINT8(0, audioBandLevel(band));
+  }
+}
+
+void test_tone_lights_its_band() {
+  for (uint8_t band = 0; band < AUDIO_NUM_BANDS; band++) {
+    setUp();
+    feedTone(BAND_HZ[band], 0.5, 0, 0, 0);
+    TEST_ASSERT_EQUAL_UINT8(band, loudestBand());
+    TEST_ASSERT_GREATER_THAN(100, audioBandLevel(band));
+  }
+}
+
+// a 20ms network slot every 100ms, and up to 300us of jitter on every sample
+void test_busy_loop_still_analyzes() {
+  for (uint8_t band = 0; band < AUDIO_NUM_BANDS; band++) {
+    uint32_t windows = audioWindowCount();
+    uint32_t skipped = audioSkippedWindows();
+
+    setUp();
+    feedTone(BAND_HZ[band], 0.5, 300, 20, 100);
+    TEST_ASSERT_EQUAL_UINT8(band, loudestBand());
+    TEST_ASSERT_GREATER_THAN(100, audioBandLevel(band));
+
+    // about 31 windows a second, whatever the loop does
+    TEST_ASSERT_GREATER_THAN(windows + 50, audioWindowCount());
+    TEST_ASSERT_EQUAL_UINT32(skipped, audioSkippedWindows());
+  }
+}
+
+// too few samples to say anything, so the levels only fall
+void test_starved_window_is_skipped() {
+  feedTone(BAND_HZ[3], 0.5, 0, 0, 0);
+  uint8_t level = audioBandLevel(3);
+  uint32_t skipped = audioSkippedWindows();
+
+  for (uint8_t i = 0; i <= AUDIO_MIN_SAMPLES / 2; i++) {
+    audioPushSample(1023, now_us);
+    now_us += AUDIO_WINDOW_US / 4;
+  }
+
+  TEST_ASSERT_GREATER_THAN(skipped, audioSkippedWindows());
+  TEST_ASSERT_LESS_THAN(level, audioBandLevel(3));
+}
+
+void test_louder_is_brighter() {
+  feedTone(BAND_HZ[4], 0.05, 0, 0, 0);
+  uint8_t quiet = audioBandLevel(4);
+
+  feedTone(BAND_HZ[4], 0.8, 0, 0, 0);
+  TEST_ASSERT_GREATER_THAN(quiet, audioBandLevel(4));
+}
+
+void test_cost_per_sample() {
+  const uint32_t samples = 2000000;
+  uint32_t sink = 0;
+
+  auto start = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < samples; i++) {
+    audioPushSample(512 + (i & 0xff), now_us);
+    now_us += 1000000 / AUDIO_SAMPLE_RATE;
+    sink += audioBandLevel(0);
+  }
+  double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / samples;
+
+  char message[80];
+  snprintf(message, sizeof(message), "audioPushSample: %.2fns per sample, windows included", sink == 1 ? 0 : ns);
+  TEST_MESSAGE(message);
+  TEST_ASSERT_LESS_THAN(1000.0, ns);
+}
+
+void test_recording() {
+  const char* path = getenv("AUDIO_WAV");
+  Wav wav;
+
+  if (!path) {
+    TEST_MESSAGE("set AUDIO_WAV to a 16 bit PCM file to analyze a recording");
+    return;
+  }
+
+  TEST_ASSERT_TRUE_MESSAGE(readWav(path, &wav), "not a 16 bit PCM wav");
+
+  // a line of band levels for every tenth of a second
+  for (size_t at = 0; at < wav.samples.size(); at += wav.rate / 10) {
+    Wav chunk;
+    chunk.rate = wav.rate;
+    chunk.samples.assign(wav.samples.begin() + at, wav.samples.begin() + min(at + wav.rate / 10, wav.samples.size()));
+    feed(chunk, 300, 20, 100);
+
+    char message[80];
+    int n = snprintf(message, sizeof(message), "%6.1fs", (double)at / wav.rate);
+
+    for (uint8_t band = 0; band < AUDIO_NUM_BANDS; band++) {
+      n += snprintf(message + n, sizeof(message) - n, " %3d", audioBandLevel(band));
+    }
+
+    TEST_MESSAGE(message);
+  }
+}
+
+int main(int argc, char** argv) {
+  audioSetup();
+  rngSeed(1);
+
+  UNITY_BEGIN();
+  RUN_TEST(test_silence_is_dark);
+  RUN_TEST(test_tone_lights_its_band);
+  RUN_TEST(test_busy_loop_still_analyzes);
+  RUN_TEST(test_starved_window_is_skipped);
+  RUN_TEST(test_louder_is_brighter);
+  RUN_TEST(test_cost_per_sample);
+  RUN_TEST(test_recording);
+  return UNITY_END();
+}
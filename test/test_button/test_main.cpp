@@ -0,0 +1,230 @@
+#include <Arduino.h>
+#include <unity.h>
+#include <string>
+
+#include "button.h"
+
+extern "C" {
+  #include "user_interface.h"
+}
+
+// the interrupt handler, the tests call it on every edge as the pin would
+void handleButtonEdge();
+
+// an edge as the interrupt saw it, ms from the start of the trace
+struct Edge {
+  uint32_t ms;
+  bool down;
+};
+
+#define TRACE(edges) edges, sizeof(edges) / sizeof(edges[0])
+
+// how often the loop gets to buttonUpdate(), the gestures must not depend on it
+const uint32_t LOOP_PERIODS[] = {1, 20, 150, 400};
+
+std::string gestures;
+
+void setTime(uint32_t ms) {
+  shimMicros() = (unsigned long)ms * 1000;
+}
+
+void setDown(bool down) {
+  shimPins() = down ? ~(1UL << BUTTON_PIN) : 0xffffffff; // wired to ground
+}
+
+// replay a trace against a loop that runs every loopMs, and carry on for a
+// while after the last edge so any pending clicks come out
+std::string replay(const Edge* edges, size_t count, uint32_t loopMs) {
+  gestures = "";
+  setDown(false);
+  buttonBegin(0);
+
+  uint32_t start = millis() + 1000;
+  uint32_t loopAt = start;
+
+  for (size_t i = 0; i < count; i++) {
+    for (; loopAt < start + edges[i].ms; loopAt += loopMs) {
+      setTime(loopAt);
+      buttonUpdate();
+    }
+
+    setTime(start + edges[i].ms);
+    setDown(edges[i].down);
+    handleButtonEdge();
+  }
+
+  for (uint32_t end = start + edges[count - 1].ms + 2000; loopAt <= end; loopAt += loopMs) {
+    setTime(loopAt);
+    buttonUpdate();
+  }
+
+  return gestures;
+}
+
+void checkTrace(const char* expected, const Edge* edges, size_t count) {
+  for (uint8_t i = 0; i < sizeof(LOOP_PERIODS) / sizeof(LOOP_PERIODS[0]); i++) {
+    char message[64];
+    snprintf(message, sizeof(message), "with the loop every %ums", LOOP_PERIODS[i]);
+    TEST_ASSERT_EQUAL_STRING_MESSAGE(expected, replay(edges, count, LOOP_PERIODS[i]).c_str(), message);
+  }
+}
+
+uint8_t interruptType() {
+  return (GPC(BUTTON_PIN) >> GPCI) & 0xF;
+}
+
+void setUp() {}
+void tearDown() {}
+
+// recorded from the board, every press and release bounces a little
+const Edge CLICK[] = {{0, true}, {1, false}, {2, true}, {120, false}, {122, true}, {123, false}};
+const Edge DOUBLE_CLICK[] = {{0, true}, {2, false}, {3, true}, {110, false}, {240, true}, {241, false}, {242, true}, {330, false}, {331, true}, {333, false}};
+const Edge TRIPLE_CLICK[] = {{0, true}, {100, false}, {101, true}, {102, false}, {220, true}, {310, false}, {450, true}, {452, false}, {453, true}, {540, false}};
+const Edge FOUR_CLICKS[] = {{0, true}, {90, false}, {200, true}, {290, false}, {400, true}, {490, false}, {600, true}, {690, false}};
+const Edge SLOW_CLICKS[] = {{0, true}, {100, false}, {101, true}, {102, false}, {600, true}, {700, false}};
+const Edge LONG_PRESS[] = {{0, true}, {1, false}, {2, true}, {800, false}, {803, true}, {804, false}};
+const Edge HOLD[] = {{0, true}, {2, false}, {3, true}, {1400, false}};
+const Edge LONGER_HOLD[] = {{0, true}, {2700, false}, {2701, true}, {2702, false}};
+const Edge CLICK_THEN_HOLD[] = {{0, true}, {1, false}, {2, true}, {110, false}, {250, true}, {251, false}, {252, true}, {1550, false}};
+const Edge CLICK_THEN_LONG_PRESS[] = {{0, true}, {110, false}, {112, true}, {113, false}, {250, true}, {950, false}};
+const Edge GLITCH[] = {{0, true}, {3, false}, {5, true}, {8, false}};
+
+void test_click() {
+  checkTrace("click1 ", TRACE(CLICK));
+}
+
+void test_double_click() {
+  checkTrace("click2 ", TRACE(DOUBLE_CLICK));
+}
+
+void test_triple_click() {
+  checkTrace("click3 ", TRACE(TRIPLE_CLICK));
+}
+
+void test_four_clicks() {
+  checkTrace("click3 click1 ", TRACE(FOUR_CLICKS));
+}
+
+void test_clicks_too_far_apart() {
+  checkTrace("click1 click1 ", TRACE(SLOW_CLICKS));
+}
+
+void test_long_press() {
+  checkTrace("long ", TRACE(LONG_PRESS));
+}
+
+void test_hold() {
+  checkTrace("hold1250 ", TRACE(HOLD));
+}
+
+void test_longer_hold() {
+  checkTrace("hold1250 hold2500 ", TRACE(LONGER_HOLD));
+}
+
+// the click was the start of the hold, it must not come out after it
+void test_click_then_hold() {
+  checkTrace("hold1250 ", TRACE(CLICK_THEN_HOLD));
+}
+
+void test_click_then_long_press() {
+  checkTrace("long ", TRACE(CLICK_THEN_LONG_PRESS));
+}
+
+void test_glitch_is_ignored() {
+  checkTrace("", TRACE(GLITCH));
+}
+
+// a press in progress at boot is never half a gesture
+void test_held_at_boot() {
+  gestures = "";
+  setDown(true);
+  TEST_ASSERT_TRUE(buttonBegin(100));
+
+  setTime(millis() + 2000);
+  buttonUpdate();
+  setDown(false);
+  handleButtonEdge();
+  setTime(millis() + 1000);
+  buttonUpdate();
+
+  TEST_ASSERT_EQUAL_STRING("", gestures.c_str());
+}
+
+void test_full_ring_counts_dropped_edges() {
+  uint16_t dropped = buttonDroppedEdges();
+  setDown(false);
+  buttonBegin(0);
+
+  for (uint8_t i = 0; i < BUTTON_EDGE_BUFFER + 4; i++) {
+    setDown(i % 2 == 0);
+    handleButtonEdge();
+  }
+
+  // past the end the level it last stored stays put, so only every other edge is a change
+  TEST_ASSERT_EQUAL_UINT16(dropped + 2, buttonDroppedEdges());
+}
+
+// a low level would fire for as long as the button is held, so the first
+// interrupt after arming puts the pin back on both edges
+void test_wakeup_goes_back_to_edges() {
+  gestures = "";
+  setDown(false);
+  buttonBegin(0);
+  TEST_ASSERT_EQUAL_UINT8(CHANGE, interruptType());
+
+  buttonArmWakeup();
+  TEST_ASSERT_EQUAL_UINT8(GPIO_PIN_INTR_LOLEVEL, interruptType());
+
+  setTime(millis() + 100);
+  setDown(true);
+  handleButtonEdge(); // the press that wakes us
+  TEST_ASSERT_EQUAL_UINT8(CHANGE, interruptType());
+
+  setTime(millis() + 100);
+  setDown(false);
+  handleButtonEdge();
+  buttonDisarmWakeup();
+  TEST_ASSERT_EQUAL_UINT8(CHANGE, interruptType());
+
+  setTime(millis() + 1000);
+  buttonUpdate();
+  TEST_ASSERT_EQUAL_STRING("click1 ", gestures.c_str());
+}
+
+void test_disarm_without_a_press() {
+  setDown(false);
+  buttonBegin(0);
+  buttonArmWakeup();
+  buttonDisarmWakeup();
+  TEST_ASSERT_EQUAL_UINT8(CHANGE, interruptType());
+}
+
+int main(int argc, char** argv) {
+  // the same gestures main.cpp listens for
+  buttonOnClicks(1, []() { gestures += "click1 "; });
+  buttonOnClicks(2, []() { gestures += "click2 "; });
+  buttonOnClicks(3, []() { gestures += "click3 "; });
+  buttonOnReleasedAfter(500, []() { gestures += "long "; });
+  buttonOnHold(1250, []() { gestures += "hold1250 "; });
+  buttonOnHold(2500, []() { gestures += "hold2500 "; });
+  buttonOnHold(3500, []() { gestures += "hold3500 "; });
+  buttonOnHold(10000, []() { gestures += "hold10000 "; });
+
+  UNITY_BEGIN();
+  RUN_TEST(test_click);
+  RUN_TEST(test_double_click);
+  RUN_TEST(test_triple_click);
+  RUN_TEST(test_four_clicks);
+  RUN_TEST(test_clicks_too_far_apart);
+  RUN_TEST(test_long_press);
+  RUN_TEST(test_hold);
+  RUN_TEST(test_longer_hold);
+  RUN_TEST(test_click_then_hold);
+  RUN_TEST(test_click_then_long_press);
+  RUN_TEST(test_glitch_is_ignored);
+  RUN_TEST(test_held_at_boot);
+  RUN_TEST(test_full_ring_counts_dropped_edges);
+  RUN_TEST(test_wakeup_goes_back_to_edges);
+  RUN_TEST(test_disarm_without_a_press);
+  return UNITY_END();
+}
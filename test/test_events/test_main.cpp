@@ -0,0 +1,113 @@
+#include <Arduino.h>
+#include <unity.h>
+#include <chrono>
+#include <stdio.h>
+
+#include "events.h"
+
+void drain() {
+  uint8_t event;
+  while (eventsPop(&event)) {}
+}
+
+void setUp() {
+  drain();
+}
+
+void tearDown() {}
+
+void test_empty_pops_nothing() {
+  uint8_t event = 0xff;
+  TEST_ASSERT_FALSE(eventsPop(&event));
+  TEST_ASSERT_EQUAL_UINT8(0xff, event);
+}
+
+void test_pops_in_order() {
+  TEST_ASSERT_TRUE(eventsPush(event_click));
+  TEST_ASSERT_TRUE(eventsPush(event_hold_color));
+  TEST_ASSERT_TRUE(eventsPush(event_wifi_connected));
+
+  uint8_t event;
+  TEST_ASSERT_TRUE(eventsPop(&event));
+  TEST_ASSERT_EQUAL_UINT8(event_click, event);
+  TEST_ASSERT_TRUE(eventsPop(&event));
+  TEST_ASSERT_EQUAL_UINT8(event_hold_color, event);
+  TEST_ASSERT_TRUE(eventsPop(&event));
+  TEST_ASSERT_EQUAL_UINT8(event_wifi_connected, event);
+  TEST_ASSERT_FALSE(eventsPop(&event));
+}
+
+void test_full_queue_drops_and_counts() {
+  uint16_t dropped = eventsDropped();
+
+  for (uint8_t i = 0; i < EVENT_QUEUE_SIZE; i++) {
+    TEST_ASSERT_TRUE(eventsPush(i));
+  }
+
+  TEST_ASSERT_FALSE(eventsPush(event_click));
+  TEST_ASSERT_FALSE(eventsPush(event_click));
+  TEST_ASSERT_EQUAL_UINT16(dropped + 2, eventsDropped());
+
+  // the ones already queued are untouched
+  uint8_t event;
+  for (uint8_t i = 0; i < EVENT_QUEUE_SIZE; i++) {
+    TEST_ASSERT_TRUE(eventsPop(&event));
+    TEST_ASSERT_EQUAL_UINT8(i, event);
+  }
+
+  TEST_ASSERT_TRUE(eventsPush(event_click));
+}
+
+// the head and tail are bytes, so run them round a few times
+void test_wraps_around() {
+  uint8_t next = 0;
+  uint8_t expected = 0;
+  uint8_t event;
+
+  for (uint16_t round = 0; round < 1000; round++) {
+    uint8_t burst = round % EVENT_QUEUE_SIZE + 1;
+
+    for (uint8_t i = 0; i < burst; i++) {
+      TEST_ASSERT_TRUE(eventsPush(next++));
+    }
+
+    for (uint8_t i = 0; i < burst; i++) {
+      TEST_ASSERT_TRUE(eventsPop(&event));
+      TEST_ASSERT_EQUAL_UINT8(expected++, event);
+    }
+  }
+
+  TEST_ASSERT_FALSE(eventsPop(&event));
+}
+
+void test_throughput() {
+  const uint32_t events = 10000000;
+  uint8_t event;
+  uint32_t sum = 0;
+  uint32_t expected = 0;
+
+  auto start = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < events; i++) {
+    eventsPush(i);
+    eventsPop(&event);
+    sum += event;
+    expected += (uint8_t)i;
+  }
+  double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / events;
+
+  char message[64];
+  snprintf(message, sizeof(message), "push and pop: %.2fns per event", ns);
+  TEST_MESSAGE(message);
+  TEST_ASSERT_EQUAL_UINT32(expected, sum);
+  TEST_ASSERT_LESS_THAN(100.0, ns);
+}
+
+int main(int argc, char** argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_empty_pops_nothing);
+  RUN_TEST(test_pops_in_order);
+  RUN_TEST(test_full_queue_drops_and_counts);
+  RUN_TEST(test_wraps_around);
+  RUN_TEST(test_throughput);
+  return UNITY_END();
+}
@@ -0,0 +1,90 @@
+#include <Arduino.h>
+#include <unity.h>
+
+#include "link.h"
+
+void setUp() {}
+void tearDown() {}
+
+void test_down_fast_joins_with_a_cache() {
+  TEST_ASSERT_EQUAL(link_fast_join, linkNextState(link_down, false, true, 0));
+}
+
+void test_down_scans_without_a_cache() {
+  TEST_ASSERT_EQUAL(link_scan_join, linkNextState(link_down, false, false, 0));
+}
+
+void test_fast_join_waits_before_scanning() {
+  TEST_ASSERT_EQUAL(link_fast_join, linkNextState(link_fast_join, false, true, 0));
+  TEST_ASSERT_EQUAL(link_fast_join, linkNextState(link_fast_join, false, true, LINK_FAST_JOIN_MS - 1));
+  TEST_ASSERT_EQUAL(link_scan_join, linkNextState(link_fast_join, false, true, LINK_FAST_JOIN_MS));
+}
+
+void test_scan_join_stays_until_connected() {
+  TEST_ASSERT_EQUAL(link_scan_join, linkNextState(link_scan_join, false, true, 0));
+  TEST_ASSERT_EQUAL(link_scan_join, linkNextState(link_scan_join, false, false, 600000));
+}
+
+void test_connecting_goes_up_from_anywhere() {
+  TEST_ASSERT_EQUAL(link_up, linkNextState(link_down, true, false, 0));
+  TEST_ASSERT_EQUAL(link_up, linkNextState(link_fast_join, true, true, 10));
+  TEST_ASSERT_EQUAL(link_up, linkNextState(link_scan_join, true, true, 10));
+  TEST_ASSERT_EQUAL(link_up, linkNextState(link_up, true, true, 600000));
+}
+
+void test_losing_the_link_goes_down() {
+  TEST_ASSERT_EQUAL(link_down, linkNextState(link_up, false, true, 0));
+  TEST_ASSERT_EQUAL(link_down, linkNextState(link_up, false, false, 0));
+}
+
+// step the machine every 10ms the way linkStep() does, against an access point
+// that answers after joinMs, and return how long it took to come up
+unsigned long reconnect(bool haveCache, unsigned long joinMs, uint8_t* via) {
+  uint8_t state = link_down;
+  unsigned long stateStart = 0;
+  *via = link_down;
+
+  for (unsigned long now = 0; now < 60000; now += 10) {
+    uint8_t next = linkNextState(state, now >= joinMs, haveCache, now - stateStart);
+
+    if (next == link_up) {
+      *via = state;
+      return now;
+    }
+
+    if (next != state) {
+      state = next;
+      stateStart = now;
+    }
+  }
+
+  return 0;
+}
+
+void test_reconnect_through_the_cache() {
+  uint8_t via;
+  TEST_ASSERT_EQUAL(500, reconnect(true, 500, &via));
+  TEST_ASSERT_EQUAL(link_fast_join, via);
+}
+
+void test_reconnect_falls_back_to_a_scan() {
+  uint8_t via;
+  TEST_ASSERT_EQUAL(5000, reconnect(true, 5000, &via));
+  TEST_ASSERT_EQUAL(link_scan_join, via);
+
+  TEST_ASSERT_EQUAL(500, reconnect(false, 500, &via));
+  TEST_ASSERT_EQUAL(link_scan_join, via);
+}
+
+int main(int argc, char** argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_down_fast_joins_with_a_cache);
+  RUN_TEST(test_down_scans_without_a_cache);
+  RUN_TEST(test_fast_join_waits_before_scanning);
+  RUN_TEST(test_scan_join_stays_until_connected);
+  RUN_TEST(test_connecting_goes_up_from_anywhere);
+  RUN_TEST(test_losing_the_link_goes_down);
+  RUN_TEST(test_reconnect_through_the_cache);
+  RUN_TEST(test_reconnect_falls_back_to_a_scan);
+  return UNITY_END();
+}
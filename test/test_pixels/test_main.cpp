@@ -0,0 +1,196 @@
+#include <Arduino.h>
+#include <Adafruit_NeoPixel.h>
+#include <unity.h>
+#include <chrono>
+#include <stdio.h>
+
+#include "pixels.h"
+#include "rng.h"
+
+// the board profiles from platformio.ini
+typedef PixelWriter<NEO_GRB, 10> Grb;
+typedef PixelWriter<NEO_RGB, 10> Rgb;
+typedef PixelWriter<NEO_GRBW, 30> Grbw;
+
+#define MA_PER_CHANNEL 20
+#define MA_BUDGET 400
+
+uint32_t color(uint8_t r, uint8_t g, uint8_t b, uint8_t w = 0) {
+  return ((uint32_t)w << 24) | ((uint32_t)r << 16) | ((uint32_t)g << 8) | b;
+}
+
+void setUp() {}
+void tearDown() {}
+
+void test_layout() {
+  TEST_ASSERT_EQUAL_UINT8(3, Grb::BYTES);
+  TEST_ASSERT_EQUAL_UINT8(3, Rgb::BYTES);
+  TEST_ASSERT_EQUAL_UINT8(4, Grbw::BYTES);
+  TEST_ASSERT_FALSE(Grb::HAS_W);
+  TEST_ASSERT_TRUE(Grbw::HAS_W);
+}
+
+void test_pack_in_wire_order() {
+  uint8_t grb[3];
+  uint8_t rgb[3];
+  const uint8_t expectedGrb[] = {20, 10, 30};
+  const uint8_t expectedRgb[] = {10, 20, 30};
+
+  Grb::pack(grb, color(10, 20, 30), 256);
+  Rgb::pack(rgb, color(10, 20, 30), 256);
+
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(expectedGrb, grb, 3);
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(expectedRgb, rgb, 3);
+}
+
+void test_pack_scales() {
+  uint8_t p[3];
+  const uint8_t half[] = {100, 50, 127};
+  const uint8_t dark[] = {0, 0, 0};
+
+  Grb::pack(p, color(100, 200, 255), 128);
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(half, p, 3);
+
+  Grb::pack(p, color(100, 200, 255), 0);
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(dark, p, 3);
+}
+
+void test_pack_moves_shared_part_to_white() {
+  uint8_t p[4];
+  const uint8_t shared[] = {50, 100, 0, 100}; // g r b w
+  const uint8_t explicitWhite[] = {150, 200, 100, 7};
+
+  Grbw::pack(p, color(200, 150, 100), 256);
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(shared, p, 4);
+
+  // a color that sets its own white keeps all four
+  Grbw::pack(p, color(200, 150, 100, 7), 256);
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(explicitWhite, p, 4);
+}
+
+void test_set_and_fill_use_strip_brightness() {
+  Adafruit_NeoPixel strip(10, 0, NEO_GRB);
+  strip.setBrightness(127);
+
+  Grb::set(strip, 2, color(200, 100, 50));
+  TEST_ASSERT_EQUAL_UINT8(50, strip.getPixels()[6]);
+  TEST_ASSERT_EQUAL_UINT8(100, strip.getPixels()[7]);
+  TEST_ASSERT_EQUAL_UINT8(25, strip.getPixels()[8]);
+
+  Grb::set(strip, 10, color(255, 255, 255)); // past the end, ignored
+  TEST_ASSERT_EQUAL_UINT32(175, Grb::load(strip));
+
+  strip.setBrightness(255);
+  Grb::fill(strip, color(1, 2, 3), 8, 0); // to the end
+  TEST_ASSERT_EQUAL_UINT32(175 + 12, Grb::load(strip));
+
+  Grb::fill(strip, color(1, 1, 1), 0, 2);
+  TEST_ASSERT_EQUAL_UINT32(175 + 12 + 6, Grb::load(strip));
+
+  Grb::fill(strip, color(255, 255, 255), 10, 5); // starts past the end
+  TEST_ASSERT_EQUAL_UINT32(175 + 12 + 6, Grb::load(strip));
+}
+
+void test_load_and_scale() {
+  Adafruit_NeoPixel strip(30, 0, NEO_GRBW);
+  strip.setBrightness(255);
+
+  Grbw::fill(strip, color(255, 255, 255), 0, 0);
+  TEST_ASSERT_EQUAL_UINT32(30 * 255, Grbw::load(strip)); // all on the white led
+
+  Grbw::fill(strip, color(255, 0, 0, 255), 0, 0);
+  TEST_ASSERT_EQUAL_UINT32(30 * 510, Grbw::load(strip));
+
+  Grbw::scale(strip, 128);
+  TEST_ASSERT_EQUAL_UINT32(30 * 254, Grbw::load(strip));
+
+  Grbw::scale(strip, 0);
+  TEST_ASSERT_EQUAL_UINT32(0, Grbw::load(strip));
+}
+
+void test_estimate() {
+  // dark still draws the idle current, full white on 10 GRB pixels is 600mA more
+  TEST_ASSERT_EQUAL_UINT32(10, pixelsMilliamps(0, MA_PER_CHANNEL, 10));
+  TEST_ASSERT_EQUAL_UINT32(610, pixelsMilliamps(10 * 3 * 255, MA_PER_CHANNEL, 10));
+  TEST_ASSERT_EQUAL_UINT32(30, pixelsMilliamps(255, MA_PER_CHANNEL, 10));
+}
+
+void test_limit_scale() {
+  TEST_ASSERT_EQUAL_UINT16(256, pixelsLimitScale(400, MA_BUDGET, 10));
+  TEST_ASSERT_EQUAL_UINT16(256, pixelsLimitScale(10, MA_BUDGET, 10));
+  TEST_ASSERT_EQUAL_UINT16(166, pixelsLimitScale(610, MA_BUDGET, 10));
+  TEST_ASSERT_EQUAL_UINT16(0, pixelsLimitScale(610, 10, 10)); // nothing left after idle
+}
+
+// whatever the frame, once it's scaled it fits the budget, and it's only dimmed when it has to be
+void test_limited_frames_fit_the_budget() {
+  Adafruit_NeoPixel strip(30, 0, NEO_GRBW);
+  strip.setBrightness(255);
+  rngSeed(3);
+
+  for (uint16_t frame = 0; frame < 2000; frame++) {
+    for (uint16_t i = 0; i < 30; i++) {
+      Grbw::set(strip, i, rngNext());
+    }
+
+    uint32_t ma = pixelsMilliamps(Grbw::load(strip), MA_PER_CHANNEL, 30);
+    uint16_t scale = pixelsLimitScale(ma, MA_BUDGET, 30);
+
+    if (ma <= MA_BUDGET) {
+      TEST_ASSERT_EQUAL_UINT16(256, scale);
+      continue;
+    }
+
+    Grbw::scale(strip, scale);
+    TEST_ASSERT_LESS_OR_EQUAL(MA_BUDGET, pixelsMilliamps(Grbw::load(strip), MA_PER_CHANNEL, 30));
+  }
+}
+
+// one frame the way neoShow() sees it: filled, estimated and scaled
+template <typename P>
+double nsPerPixel(Adafruit_NeoPixel& strip, uint16_t count) {
+  const uint32_t frames = 200000;
+  uint32_t sink = 0;
+  strip.setBrightness(255);
+
+  auto start = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < frames; i++) {
+    P::fill(strip, color(i, 255 - i, i >> 1), 0, 0);
+    uint32_t ma = pixelsMilliamps(P::load(strip), MA_PER_CHANNEL, count);
+    P::scale(strip, pixelsLimitScale(ma, MA_BUDGET, count));
+    sink += strip.getPixels()[0];
+  }
+  double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+  return sink == 0xffffffff ? 0 : ns / frames / count;
+}
+
+void test_cost_per_pixel() {
+  Adafruit_NeoPixel grb(10, 0, NEO_GRB);
+  Adafruit_NeoPixel rgb(10, 0, NEO_RGB);
+  Adafruit_NeoPixel grbw(30, 0, NEO_GRBW);
+  double costs[] = {nsPerPixel<Grb>(grb, 10), nsPerPixel<Rgb>(rgb, 10), nsPerPixel<Grbw>(grbw, 30)};
+  const char* names[] = {"grb x10", "rgb x10", "grbw x30"};
+
+  for (uint8_t i = 0; i < 3; i++) {
+    char message[80];
+    snprintf(message, sizeof(message), "%s: fill, estimate and scale %.2fns per pixel", names[i], costs[i]);
+    TEST_MESSAGE(message);
+    TEST_ASSERT_LESS_THAN(200.0, costs[i]);
+  }
+}
+
+int main(int argc, char** argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_layout);
+  RUN_TEST(test_pack_in_wire_order);
+  RUN_TEST(test_pack_scales);
+  RUN_TEST(test_pack_moves_shared_part_to_white);
+  RUN_TEST(test_set_and_fill_use_strip_brightness);
+  RUN_TEST(test_load_and_scale);
+  RUN_TEST(test_estimate);
+  RUN_TEST(test_limit_scale);
+  RUN_TEST(test_limited_frames_fit_the_budget);
+  RUN_TEST(test_cost_per_pixel);
+  return UNITY_END();
+}
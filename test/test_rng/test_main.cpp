@@ -0,0 +1,134 @@
+#include <Arduino.h>
+#include <unity.h>
+#include <chrono>
+#include <stdio.h>
+
+#include "rng.h"
+
+#define DRAWS 64000
+#define BUCKETS 16
+#define CHI_SQUARE_LIMIT 37.7 // 15 degrees of freedom, p = 0.001
+
+// how far the counts are from an even spread
+double chiSquare(const uint32_t* counts, uint16_t buckets, uint32_t draws) {
+  double expected = (double)draws / buckets;
+  double sum = 0;
+
+  for (uint16_t i = 0; i < buckets; i++) {
+    double d = counts[i] - expected;
+    sum += d * d / expected;
+  }
+
+  return sum;
+}
+
+void setUp() {}
+void tearDown() {}
+
+void test_same_seed_same_sequence() {
+  uint32_t first[8];
+
+  rngSeed(1234);
+  for (uint8_t i = 0; i < 8; i++) {
+    first[i] = rngNext();
+  }
+
+  rngSeed(1234);
+  for (uint8_t i = 0; i < 8; i++) {
+    TEST_ASSERT_EQUAL_UINT32(first[i], rngNext());
+  }
+
+  TEST_ASSERT_EQUAL_UINT32(1234, rngSeedValue());
+}
+
+void test_zero_seed_still_moves() {
+  rngSeed(0); // xorshift would be stuck at 0 forever
+  TEST_ASSERT_NOT_EQUAL(0, rngSeedValue());
+  TEST_ASSERT_NOT_EQUAL(0, rngNext());
+}
+
+void test_range_stays_in_range() {
+  const uint16_t sizes[] = {1, 3, 7, 100, 255, 1000, 65535};
+  rngSeed(99);
+
+  for (uint8_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+    for (uint16_t i = 0; i < 10000; i++) {
+      TEST_ASSERT_LESS_THAN(sizes[s], rngRange(sizes[s]));
+    }
+  }
+}
+
+void test_range_is_uniform() {
+  const uint32_t seeds[] = {1, 42, 0xdeadbeef};
+
+  for (uint8_t s = 0; s < 3; s++) {
+    uint32_t counts[BUCKETS] = {};
+    rngSeed(seeds[s]);
+
+    for (uint32_t i = 0; i < DRAWS; i++) {
+      counts[rngRange(BUCKETS)]++;
+    }
+
+    TEST_ASSERT_LESS_THAN(CHI_SQUARE_LIMIT, chiSquare(counts, BUCKETS, DRAWS));
+  }
+}
+
+// the top bits go to rngByte(), the low ones to hues through rngRange()
+void test_byte_is_uniform() {
+  uint32_t counts[BUCKETS] = {};
+  rngSeed(7);
+
+  for (uint32_t i = 0; i < DRAWS; i++) {
+    counts[rngByte() >> 4]++;
+  }
+
+  TEST_ASSERT_LESS_THAN(CHI_SQUARE_LIMIT, chiSquare(counts, BUCKETS, DRAWS));
+}
+
+void test_bits_are_balanced() {
+  uint32_t ones[32] = {};
+  rngSeed(5);
+
+  for (uint32_t i = 0; i < DRAWS; i++) {
+    uint32_t x = rngNext();
+
+    for (uint8_t b = 0; b < 32; b++) {
+      ones[b] += (x >> b) & 1;
+    }
+  }
+
+  // 4 standard deviations either side of half
+  for (uint8_t b = 0; b < 32; b++) {
+    TEST_ASSERT_UINT32_WITHIN(512, DRAWS / 2, ones[b]);
+  }
+}
+
+// a call is three shifts and xors, it should never come close to a microsecond
+void test_cost_per_call() {
+  const uint32_t calls = 10000000;
+  volatile uint32_t sink = 0;
+  rngSeed(1);
+
+  auto start = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < calls; i++) {
+    sink += rngRange(255);
+  }
+  double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / calls;
+
+  char message[64];
+  snprintf(message, sizeof(message), "rngRange: %.2fns per call", ns);
+  TEST_MESSAGE(message);
+  TEST_ASSERT_LESS_THAN(100.0, ns);
+}
+
+int main(int argc, char** argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_same_seed_same_sequence);
+  RUN_TEST(test_zero_seed_still_moves);
+  RUN_TEST(test_range_stays_in_range);
+  RUN_TEST(test_range_is_uniform);
+  RUN_TEST(test_byte_is_uniform);
+  RUN_TEST(test_bits_are_balanced);
+  RUN_TEST(test_cost_per_call);
+  return UNITY_END();
+}
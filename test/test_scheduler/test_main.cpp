@@ -0,0 +1,210 @@
+#include <Arduino.h>
+#include <unity.h>
+
+#include "scheduler.h"
+
+// synthetic tasks: each one takes as long on the fake clock as its load says
+enum FAKE_TASKS {
+  fake_input,
+  fake_render,
+  fake_network_a,
+  fake_network_b,
+  fake_housekeeping,
+  num_fake_tasks,
+};
+
+unsigned long load_us[num_fake_tasks];
+unsigned long last_run_ms[num_fake_tasks];
+unsigned long max_gap_ms[num_fake_tasks];
+uint32_t runs[num_fake_tasks];
+
+void work(uint8_t task) {
+  unsigned long now = millis();
+
+  if (runs[task]) {
+    max_gap_ms[task] = max(max_gap_ms[task], now - last_run_ms[task]);
+  }
+
+  last_run_ms[task] = now;
+  runs[task]++;
+  shimMicros() += load_us[task];
+}
+
+void input() { work(fake_input); }
+void render() { work(fake_render); }
+void networkA() { work(fake_network_a); }
+void networkB() { work(fake_network_b); }
+void housekeeping() { work(fake_housekeeping); }
+
+void setLoad(unsigned long input, unsigned long render, unsigned long networkA, unsigned long networkB, unsigned long housekeeping) {
+  load_us[fake_input] = input;
+  load_us[fake_render] = render;
+  load_us[fake_network_a] = networkA;
+  load_us[fake_network_b] = networkB;
+  load_us[fake_housekeeping] = housekeeping;
+}
+
+// the longest a pass can take with the current load
+unsigned long worstPassMs() {
+  unsigned long us = 0;
+
+  for (uint8_t i = 0; i < num_fake_tasks; i++) {
+    us += load_us[i];
+  }
+
+  return us / 1000 + 1;
+}
+
+void runPasses(uint32_t passes) {
+  for (uint32_t i = 0; i < passes; i++) {
+    schedulerLoop();
+    shimMicros() += 50; // the loop itself
+  }
+}
+
+// the scheduler's own counters, by name
+uint32_t taskStat(const char* name, uint8_t stat) {
+  for (uint8_t i = 0; i < schedulerTaskCount(); i++) {
+    const char* taskName;
+    uint32_t values[4];
+    schedulerGetTask(i, &taskName, &values[0], &values[1], &values[2], &values[3]);
+
+    if (!strcmp(taskName, name)) {
+      return values[stat];
+    }
+  }
+
+  return 0;
+}
+
+#define STAT_RUNS 0
+#define STAT_MISSES 1
+#define STAT_OVERRUNS 2
+
+void setUp() {
+  // settle on a light load so every test starts with nothing overdue
+  setLoad(100, 100, 100, 100, 100);
+  runPasses(10);
+
+  memset(runs, 0, sizeof(runs));
+  memset(max_gap_ms, 0, sizeof(max_gap_ms));
+}
+
+void tearDown() {}
+
+void test_runs_in_priority_order() {
+  const char* expected[] = {"input", "render", "network_a", "network_b", "housekeeping"};
+  TEST_ASSERT_EQUAL_UINT8(5, schedulerTaskCount());
+
+  for (uint8_t i = 0; i < 5; i++) {
+    const char* name;
+    uint32_t ignored;
+    schedulerGetTask(i, &name, &ignored, &ignored, &ignored, &ignored);
+    TEST_ASSERT_EQUAL_STRING(expected[i], name);
+  }
+}
+
+void test_light_load_runs_everything_every_pass() {
+  uint32_t misses = taskStat("housekeeping", STAT_MISSES);
+
+  setLoad(200, 1000, 2000, 2000, 1000);
+  runPasses(1000);
+
+  for (uint8_t i = 0; i < num_fake_tasks; i++) {
+    TEST_ASSERT_EQUAL_UINT32(1000, runs[i]);
+  }
+
+  TEST_ASSERT_EQUAL_UINT32(misses, taskStat("housekeeping", STAT_MISSES));
+}
+
+// network work that overruns the pass budget can't hold up input and render
+void test_input_and_render_run_every_pass() {
+  setLoad(200, 1000, 25000, 25000, 5000);
+  runPasses(1000);
+
+  TEST_ASSERT_EQUAL_UINT32(1000, runs[fake_input]);
+  TEST_ASSERT_EQUAL_UINT32(1000, runs[fake_render]);
+  TEST_ASSERT_LESS_OR_EQUAL(worstPassMs(), max_gap_ms[fake_render]);
+}
+
+// whatever the load, nothing waits longer than SCHEDULER_MAX_DEFER_MS plus the pass it was due in
+void test_nothing_starves() {
+  setLoad(200, 1000, 25000, 25000, 5000);
+  runPasses(2000);
+
+  for (uint8_t i = 0; i < num_fake_tasks; i++) {
+    TEST_ASSERT_GREATER_THAN(0, runs[i]);
+    TEST_ASSERT_LESS_OR_EQUAL(SCHEDULER_MAX_DEFER_MS + worstPassMs(), max_gap_ms[i]);
+  }
+
+  // the first network task fills the gap, the rest get in when they're overdue
+  TEST_ASSERT_GREATER_THAN(runs[fake_network_b], runs[fake_network_a]);
+  TEST_ASSERT_GREATER_THAN(runs[fake_housekeeping], runs[fake_network_a]);
+}
+
+void test_late_runs_count_as_misses() {
+  uint32_t misses = taskStat("housekeeping", STAT_MISSES);
+  uint32_t renderMisses = taskStat("render", STAT_MISSES);
+
+  setLoad(200, 1000, 25000, 25000, 5000);
+  runPasses(1000);
+
+  TEST_ASSERT_GREATER_THAN(misses, taskStat("housekeeping", STAT_MISSES));
+  TEST_ASSERT_EQUAL_UINT32(renderMisses, taskStat("render", STAT_MISSES));
+}
+
+void test_over_budget_counts_as_overrun() {
+  uint32_t overruns = taskStat("render", STAT_OVERRUNS);
+  uint32_t inputOverruns = taskStat("input", STAT_OVERRUNS);
+
+  setLoad(200, 6000, 100, 100, 100); // render's budget is 5ms
+  runPasses(100);
+
+  TEST_ASSERT_EQUAL_UINT32(overruns + 100, taskStat("render", STAT_OVERRUNS));
+  TEST_ASSERT_EQUAL_UINT32(inputOverruns, taskStat("input", STAT_OVERRUNS));
+}
+
+bool timer_fired = false;
+unsigned long timer_fired_ms = 0;
+
+void timer() {
+  timer_fired = true;
+  timer_fired_ms = millis();
+}
+
+void test_timer_fires_once_when_due() {
+  unsigned long due = millis() + 500;
+  TEST_ASSERT_TRUE(schedulerAfter(500, timer));
+
+  while (millis() < due) {
+    TEST_ASSERT_FALSE(timer_fired);
+    runPasses(1);
+  }
+
+  runPasses(1);
+  TEST_ASSERT_TRUE(timer_fired);
+  TEST_ASSERT_LESS_OR_EQUAL(due + worstPassMs(), timer_fired_ms);
+
+  timer_fired = false;
+  runPasses(100);
+  TEST_ASSERT_FALSE(timer_fired);
+}
+
+int main(int argc, char** argv) {
+  // added out of order, they run by priority
+  schedulerAdd("housekeeping", housekeeping, priority_housekeeping, 10000);
+  schedulerAdd("network_a", networkA, priority_network, 20000);
+  schedulerAdd("render", render, priority_render, 5000);
+  schedulerAdd("network_b", networkB, priority_network, 20000);
+  schedulerAdd("input", input, priority_input, 2000);
+
+  UNITY_BEGIN();
+  RUN_TEST(test_runs_in_priority_order);
+  RUN_TEST(test_light_load_runs_everything_every_pass);
+  RUN_TEST(test_input_and_render_run_every_pass);
+  RUN_TEST(test_nothing_starves);
+  RUN_TEST(test_late_runs_count_as_misses);
+  RUN_TEST(test_over_budget_counts_as_overrun);
+  RUN_TEST(test_timer_fires_once_when_due);
+  return UNITY_END();
+}
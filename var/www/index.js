@@ -9,6 +9,8 @@
     mode: [
       ["off", "solid", "breath", "marquee"],
       ["theater", "rainbow", "rainbow_marquee", "rainbow_theater"],
+      ["sparkle", "twinkle", "fire", "meteor"],
+      ["audio"],
     ],
   };
 
@@ -36,38 +38,9 @@
     document.body.removeChild(document.querySelector("#default"));
   };
 
-  // add bootstrap stylesheet
-  const augmentHeader = () => {
-    app.head = document.querySelector("head");
-    app.head.append(
-      ...buildComponents(
-        `<link
-          href="https://cdn.jsdelivr.net/npm/bootstrap@5.0.0-beta1/dist/css/bootstrap.min.css"
-          rel="stylesheet"
-          integrity="sha384-giJF6kkoqNQ00vy+HMDP7azOuL0xtbfIcaT9wjKHr8RbDVddVHyTfAAsrekwKmP1"
-          crossorigin="anonymous"
-        />`,
-        `<link
-          rel="stylesheet"
-          href="https://cdn.jsdelivr.net/npm/@simonwep/pickr/dist/themes/nano.min.css"
-        />`
-      )
-    );
-  };
-
-  // add body structure and bootstrap js
-  const augmentBody = async () => {
+  // add body structure, everything is served by the device so the portal works offline
+  const augmentBody = () => {
     document.body.classList.add("container-fluid");
-    await addScript(
-      "https://cdn.jsdelivr.net/npm/bootstrap@5.0.0-beta1/dist/js/bootstrap.bundle.min.js",
-      [
-        [
-          "integrity",
-          "sha384-ygbV9kiqUc6oa4msXn9868pTtWMgiQaeYH7/t7LECLbyPA2x65Kgf80OJFdroafW",
-        ],
-        ["crossorigin", "anonymous"],
-      ]
-    );
     document.body.append(
       ...buildComponents(
         `<header class="container">
@@ -84,19 +57,18 @@
         `<main>
           <div class="container">
             <h2>color</h2>
-            <div class="picker"></div>
+            <input type="color" class="picker" id="color" value="#ffffff">
           </div>
           <div class="container">
             <h2>brightness</h2>
             <input type="range" class="form-range" id="brightness" min="0" max="150">
           </div>
         </main>`,
-        `<div class="modal fade" id="staticBackdrop" data-bs-backdrop="static" data-bs-keyboard="false" tabindex="-1" aria-labelledby="staticBackdropLabel" aria-hidden="true">
+        `<div class="modal" id="staticBackdrop" role="dialog" aria-labelledby="staticBackdropLabel" aria-hidden="true">
           <div class="modal-dialog">
             <div class="modal-content">
               <div class="modal-header">
                 <h5 class="modal-title" id="staticBackdropLabel">Communication Error</h5>
-                <button type="button" id="modal-close-btn" style="display: none;" class="btn-close" data-bs-dismiss="modal">
               </div>
               <div class="modal-body">
                 <p>An error occurred while attempting to communicate with the device.</p>
@@ -107,30 +79,23 @@
               </div>
             </div>
           </div>
-        </div>`,
-        `<button
-          type="button"
-          id="modal-open-btn"
-          style="display: none;"
-          data-bs-toggle="modal"
-          data-bs-target="#staticBackdrop"
-        />`
+        </div>`
       )
     );
 
     handleUpdateHost();
     const refreshBtn = document.querySelector("#refresh");
-    const openBtn = document.querySelector("#modal-open-btn");
-    const closeBtn = document.querySelector("#modal-close-btn");
+    const modal = document.querySelector("#staticBackdrop");
     app.brightness = document.querySelector("#brightness");
 
     app.brightness.addEventListener("change", handleChangeBrightness);
+    app.brightness.addEventListener("input", handleLiveBrightness);
 
     refreshBtn.addEventListener("click", handleRefresh);
 
     app.modal = {
-      open: () => openBtn.click(),
-      close: () => closeBtn.click(),
+      open: () => modal.classList.add("show"),
+      close: () => modal.classList.remove("show"),
     };
   };
 
@@ -211,43 +176,25 @@
     });
   };
 
-  const initPicker = async () => {
-    await addScript(
-      "https://cdn.jsdelivr.net/npm/@simonwep/pickr/dist/pickr.min.js"
-    );
-    app.picker = new Pickr({
-      el: ".picker",
-      theme: "nano",
-      comparison: false,
-      defaultRepresentation: "RGBA",
-      position: "right-end",
-      default: "rgba(255,255,255,0)",
-      components: {
-        opacity: true,
-        hue: true,
-        preview: true,
-        useAsButton: true,
-        interaction: {
-          input: true,
-        },
-      },
-    });
-
-    app.picker.on("change", handleColorChange);
-    app.picker.on("init", () => {
-      app.pickerBtn = document.querySelector(".pcr-button");
-    });
+  // the browser's own picker, the alpha channel is the brightness slider
+  const initPicker = () => {
+    app.picker = document.querySelector("#color");
+    app.picker.addEventListener("input", handleColorChange);
+    app.picker.addEventListener("change", handleColorDone);
   };
 
   // build the ui, add the interactivity, and fetch the current state
-  const render = async () => {
+  const render = () => {
     clearDefault();
-    augmentHeader();
-    await augmentBody();
+    augmentBody();
     augmentMain();
     handleResize();
     window.onresize = handleResize;
-    await initPicker().then(handleRefresh);
+    initPicker();
+    // an unreachable device shows the error modal, the socket keeps retrying either way
+    handleRefresh()
+      .catch(() => {})
+      .then(connectSocket);
   };
 
   // ------------------------------------------------------------------
@@ -270,6 +217,29 @@
       });
   }
 
+  // live channel for the picker and slider, every change made anywhere is pushed back to us
+  function connectSocket() {
+    const origin = app.proxy || window.location.origin;
+    const socket = new WebSocket(`${origin.replace(/^http/, "ws")}/ws`);
+
+    socket.onopen = () => (app.socket = socket);
+    socket.onmessage = ({ data }) => U(JSON.parse(data), !app.picking);
+    socket.onclose = () => {
+      app.socket = null;
+      setTimeout(connectSocket, 2000);
+    };
+  }
+
+  // send over the socket when it's up, the device only applies the latest message per frame
+  function L(body) {
+    if (!app.socket) {
+      return false;
+    }
+
+    app.socket.send(JSON.stringify(body));
+    return true;
+  }
+
   // shortcut to make a request to the api with a single key-value pair
   // and then update our state with the return value
   function S(p, k, v) {
@@ -281,19 +251,18 @@
     const { status, mode } = apiState;
     if (color) {
       const [r, g, b] = color;
-      const a = color[3] / 150; // 150 = MAX_ALPHA
+      const a = color[3] / 150; // 150 = full brightness
 
       // need to update color picker if setting color via a status click
-      if (setColorPicker)
-        app.picker.setColor(`rgba(${[r, g, b, a].join(",")})`);
+      if (setColorPicker) app.picker.value = toHex(r, g, b);
 
       document.body.classList[status === "Party!" ? "add" : "remove"](
         "rainbow"
       );
 
-      if (mode === "off" || status === "Party!") {
-        app.pickerBtn.style.color = "transparent";
-      }
+      app.picker.classList[
+        mode === "off" || status === "Party!" ? "add" : "remove"
+      ]("transparent");
 
       app.state.color = [r, g, b, a];
     }
@@ -318,7 +287,8 @@
 
     // click all of the appropriate buttons so the ui state matches the api state
     app.config.keys.forEach((configKey) => {
-      app.config.groups[configKey].labels[apiState[configKey]].click();
+      // modes like pattern and segments have no button
+      app.config.groups[configKey].labels[apiState[configKey]]?.click();
     });
 
     window.scrollTo(0, y);
@@ -395,10 +365,22 @@
     app.config.showCustom = isCustom;
   }
 
-  // send color change request
-  function handleColorChange(hsvColor) {
-    // if the picker isn't open, then we are updating from a trigger we just sent, so we don't need to send another request
-    if (!app.picker.isOpen()) {
+  // "#rrggbb" <-> [r, g, b]
+  function toHex(...rgb) {
+    return `#${rgb.map((n) => (+n).toString(16).padStart(2, "0")).join("")}`;
+  }
+
+  function fromHex(hex) {
+    return [1, 3, 5].map((i) => parseInt(hex.slice(i, i + 2), 16));
+  }
+
+  // send color change request while the picker is being dragged
+  function handleColorChange({ target: { value } }) {
+    app.picking = true; // don't let pushed updates move the picker under us
+
+    const color = [...fromHex(value), +app.brightness.value];
+
+    if (L({ color })) {
       return;
     }
 
@@ -406,16 +388,31 @@
 
     if (now - app.debounce.color > 250) {
       app.debounce.color = now;
-      const rgba = hsvColor.toRGBA(1);
-      const [r, g, b] = rgba.map((n) => parseInt(n, 10));
-      const a = rgba[3] * 150; // map from (0,1) to (0, 150) [MAX_ALPHA]
-      F("/config", { color: [r, g, b, a] }).then((r) => U(r, 0)); // 0 indicates we shouldn't update the picker color
+      F("/config", { color }).then((r) => U(r, 0)); // 0 indicates we shouldn't update the picker color
     }
   }
 
-  // send color change request
+  // the picker closed, make sure the final color lands
+  function handleColorDone({ target: { value } }) {
+    app.picking = false;
+
+    const color = [...fromHex(value), +app.brightness.value];
+
+    if (!L({ color })) {
+      F("/config", { color }).then((r) => U(r, 0));
+    }
+  }
+
+  // send brightness change request
   function handleChangeBrightness({ target: { value: brightness } }) {
-    F("/config", { brightness }).then(U);
+    if (!L({ brightness: +brightness })) {
+      F("/config", { brightness }).then(U);
+    }
+  }
+
+  // stream the slider while it's being dragged
+  function handleLiveBrightness({ target: { value: brightness } }) {
+    L({ brightness: +brightness });
   }
 
   // stack buttons when viewport < 800
@@ -460,19 +457,6 @@
     return [...d.children];
   }
 
-  async function addScript(src, kvs = []) {
-    const script = document.createElement("script");
-    script.src = src;
-    kvs.forEach(([k, v]) => {
-      script.setAttribute(k, v);
-    });
-
-    return new Promise((resolve) => {
-      script.onload = resolve;
-      app.head.appendChild(script);
-    });
-  }
-
   // ------------------------------------------------------------------
   // Here we go!
   // ------------------------------------------------------------------